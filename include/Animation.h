@@ -1,13 +1,16 @@
 ﻿#pragma once
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
 #include "GlobalTransport.h"
+#include "Trace.h"
 #include <iostream>
 
 enum class EasingType;
 enum class LoopType;
 class AnimationPoint;
+class AnimationCurve;
 
 class Animation {
 public:
@@ -27,7 +30,7 @@ public:
 
 	void resetAnimation();
 
-	void setTrigger(bool t) { hasTrigger_ = t; }
+	void setTrigger(bool t);
 	void trigger() { isTriggered_ = true; }
 	bool hasTrigger() { return hasTrigger_; }
 	bool is_finished() { return is_finished_; }
@@ -39,8 +42,19 @@ public:
 
 	float easingFunction(float);
 	void setTotalDuration();
+	float getTotalDuration() const { return totalDuration_; }
 	float getEasedTime(float);
 
+	// Baked form of this animation (see AnimationCurve), recompiled when
+	// AnimationEpoch has moved on; null if it has to be interpreted
+	const AnimationCurve* bakedCurve();
+	std::size_t* bakedCursor() { return &curveCursor_; }
+	float getStartTime() const { return originalStartPoint_; }
+
+	// Result of a batch evaluation at time t; getValue(t) returns it instead
+	// of interpreting the points
+	void setBakedValue(float t, glm::vec2 value, bool finished);
+
 private:
 	std::vector<std::shared_ptr<AnimationPoint>> points_;
 	std::size_t pointsIndex_ = 0;
@@ -67,4 +81,13 @@ private:
 	float easedElapsedTime_ = 0.000f;
 
 	bool is_finished_ = false;
+
+	std::shared_ptr<const AnimationCurve> curve_;
+	std::uint64_t curveEpoch_ = 0;
+	std::size_t curveCursor_ = 0;
+
+	bool hasBakedValue_ = false;
+	bool bakedFinished_ = false;
+	float bakedTime_ = 0.000f;
+	glm::vec2 bakedValue_{};
 };
\ No newline at end of file
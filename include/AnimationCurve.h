@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+
+class Animation;
+
+// An Animation compiled to a flat array of keyframe segments.
+//
+// Each AnimationPoint becomes one segment holding its start time (the prefix
+// sum of the durations before it), the reciprocal of its duration, the
+// endpoints of its current path and that path's easing as quadratic
+// coefficients: every EasingType is c0 + u·(c1 + u·c2) on each side of u = ½,
+// so evaluating a segment is a clamp, two polynomials and a select, with no
+// switch and no pointer chasing. The animation-level easing that warps the
+// whole timeline is stored the same way.
+//
+// Only animations whose playback is a pure function of elapsed time can be
+// baked: no trigger, no Random loop, and a Sequence loop only with Linear
+// easing and without points that cycle between several paths. compile()
+// returns null for the rest and Animation::getValue interprets them as before.
+class AnimationCurve {
+public:
+    struct Segment {
+        float start;           // ms from the start of the animation
+        float invDuration;
+        glm::vec2 from;
+        glm::vec2 delta;       // to - from
+        glm::vec2 to;          // returned exactly once u reaches 1, as AnimationPath does
+        float lo[3];           // easing for u < 0.5
+        float hi[3];           // easing for u >= 0.5
+    };
+
+    static std::shared_ptr<const AnimationCurve> compile(Animation& animation);
+
+    float totalDuration() const { return total_; }
+    bool loops() const { return loops_; }
+    const std::vector<Segment>& segments() const { return segments_; }
+
+    // Animation easing applied to `elapsed` ms; wrapped into [0, total) for a
+    // Sequence loop. `finished` is set once a non-looping curve has run out.
+    float warp(float elapsed, bool& finished) const;
+
+    // Index of the segment containing `w`, trying `hint` and its successor
+    // before falling back to a binary search
+    std::size_t locate(float w, std::size_t hint) const;
+
+    // Scalar reference evaluation; the batch below must agree with it
+    glm::vec2 sample(float elapsed, bool& finished, std::size_t& cursor) const;
+
+    // Evaluates many curves at once: add() each job, evaluate(), then read
+    // values/finished in the same order. Jobs are processed `chunk` at a time;
+    // callers that flush every `chunk` jobs find their animations still in
+    // cache when they hand the results back.
+    struct Batch {
+        static constexpr std::size_t chunk = 64;
+
+        struct Job {
+            const AnimationCurve* curve;
+            float elapsed;          // ms since the animation started
+            std::size_t* cursor;    // segment hint, updated in place
+        };
+        std::vector<Job> jobs;
+
+        std::vector<glm::vec2> values;
+        std::vector<std::uint8_t> finished;
+
+        void clear();
+        void add(const AnimationCurve* curve, float elapsedMs, std::size_t* cursor);
+        void evaluate();
+
+    private:
+        // Structure-of-arrays copy of a chunk of jobs' segments
+        struct Lanes {
+            static constexpr std::size_t size = chunk;
+            alignas(16) float w[size], start[size], invDuration[size];
+            alignas(16) float lo0[size], lo1[size], lo2[size], hi0[size], hi1[size], hi2[size];
+            alignas(16) float fromX[size], fromY[size], deltaX[size], deltaY[size], toX[size], toY[size];
+            alignas(16) float x[size], y[size];
+        };
+        Lanes lanes_;
+    };
+
+private:
+    std::vector<Segment> segments_;
+    float total_ = 0.0f;
+    float invTotal_ = 0.0f;
+    float warpLo_[3] = { 0.0f, 1.0f, 0.0f };
+    float warpHi_[3] = { 0.0f, 1.0f, 0.0f };
+    bool snap_ = false;    // EaseOut / EaseInOut round anything above 0.999 up to 1
+    bool loops_ = false;
+};
@@ -1,6 +1,15 @@
 #pragma once
+#include <cstdint>
 #include <glm/glm.hpp>
 #include <iostream>
+#include "Trace.h"
+
+// Bumped whenever an animation, point or path is edited; baked curves (see
+// AnimationCurve) are recompiled when their Animation sees it has moved on.
+namespace AnimationEpoch {
+	inline std::uint64_t current = 1;
+	inline void bump() { ++current; }
+}
 
 enum class EasingType {
 	Linear,
@@ -24,7 +33,10 @@ public:
 	std::shared_ptr<AnimationPath> clone() const;
 
 	float easingFunction(float t);
-	void setEasingType(EasingType type) { easing_ = type; }
+	void setEasingType(EasingType type) {
+		easing_ = type;
+		AnimationEpoch::bump();
+	}
 	const EasingType& getEasingType() const { return easing_; }
 
 	glm::vec2 updateValue(float t);
@@ -34,10 +46,12 @@ public:
 	void setStart(glm::vec2 val) {
 		start_ = val;
 		distance_ = end_ - start_;
+		AnimationEpoch::bump();
 	}
 	void setEnd(glm::vec2 val) { 
 		end_ = val;
 		distance_ = end_ - start_;
+		AnimationEpoch::bump();
 		if(endPoint_.lock()) {
 			updateEndPoint(val);
 		}
@@ -46,6 +60,7 @@ public:
 	void setEndPoint(const std::shared_ptr<AnimationPoint>& pt) {
 		endPoint_ = pt;
 	}
+	std::shared_ptr<AnimationPoint> getEndPoint() const { return endPoint_.lock(); }
 	void updateEndPoint(glm::vec2 val);
 
 private:
@@ -89,7 +104,7 @@ inline float AnimationPath::easingFunction(float t) {
 
 inline glm::vec2 AnimationPath::updateValue(float t) {
 	// 1) force t into [0,1]
-	std::cout << "t = " << t << '\n';
+	TRACE_VERBOSE("t = {}", t);
 	t = glm::clamp(t, 0.0f, 1.0f);
 
 	// 2) at exactly 100%, just return the end point
@@ -57,7 +57,10 @@ public:
 
     // Access and modify paths
     std::vector<std::shared_ptr<AnimationPath>>& getPaths() { return paths_; }
-    void addPath(const std::shared_ptr<AnimationPath>& newPath) { paths_.push_back(newPath); }
+    void addPath(const std::shared_ptr<AnimationPath>& newPath) {
+        paths_.push_back(newPath);
+        AnimationEpoch::bump();
+    }
 
     // Store weak references to associated paths
     void addAssociatedPath(const std::shared_ptr<AnimationPath>& newAssPtr) {
@@ -71,6 +74,7 @@ public:
 	LoopType getLoopType() const { return loopType_; }
 
     void updatePathIndex();
+    std::size_t getPathIndex() const { return path_index_; }
 
 private:
     glm::vec2 value_;
@@ -101,6 +105,7 @@ inline glm::vec2 AnimationPoint::getValue(float t) {
 
 inline void AnimationPoint::setValue(glm::vec2 val) {
     value_ = val;
+    AnimationEpoch::bump();
     // Update start value of all paths
     for (auto& path : paths_) {
         path->setStart(val);
@@ -108,7 +113,7 @@ inline void AnimationPoint::setValue(glm::vec2 val) {
     // Update end value of all associated paths if they still exist
     for (auto& weakPath : associatedPaths_) {
         if (auto path = weakPath.lock()) {
-			std::cout << "Updating associated path end value." << std::endl;
+			TRACE_VERBOSE("Updating associated path end value.");
             path->setEnd(val);
         }
     }
@@ -116,6 +121,7 @@ inline void AnimationPoint::setValue(glm::vec2 val) {
 
 inline void AnimationPoint::setValueThroughEnd(glm::vec2 val) {
     value_ = val;
+    AnimationEpoch::bump();
     // Update start value of all paths
     for (auto& path : paths_) {
         path->setStart(val);
@@ -128,10 +134,11 @@ inline float AnimationPoint::getDuration() {
 
 inline void AnimationPoint::setDuration(float dur) {
     duration_ = dur;
+    AnimationEpoch::bump();
 }
 
 inline void AnimationPoint::updatePathIndex() {
-    std::cout << "Updating path index\n";
+    TRACE_VERBOSE("Updating path index");
 
     switch (loopType_) {
     case LoopType::Sequence: {
@@ -153,4 +160,5 @@ inline void AnimationPoint::updatePathIndex() {
 inline void AnimationPoint::setLoopType(LoopType loop) {
     loopType_ = loop;
     path_index_ = 0;
+    AnimationEpoch::bump();
 }
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+
+struct Scene;
+
+// Drives the animations of a scene once per frame.
+//
+// Every object's current animation that bakes to an AnimationCurve is
+// evaluated in one AnimationCurve::Batch, and each result handed back to its
+// Animation; GraphicObject::update then runs as before, picking those values
+// up and interpreting only the animations that could not be baked.
+namespace AnimationSystem {
+    // At GlobalTransport::currentTime, on the thread that owns the scene
+    void update(Scene& scene);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+// Transport clock driven by the frames the audio callback renders.
+//
+// The callback stamps its running frame count together with the host time at
+// which it ran; the UI thread reads that stamp through a Seqlock and
+// interpolates between callbacks with the host clock (never further than one
+// period, so a stalled device freezes the clock rather than letting it run
+// ahead of the sound). Visuals use audibleTime(), which subtracts the device's
+// output latency so they line up with what is actually coming out of the
+// speakers; track start/stop uses renderTime(), the position the mixer is
+// writing.
+namespace AudioClock {
+    // ─── audio thread ───
+    void advance(std::uint32_t frameCount);   // once per callback, after mixing
+
+    // ─── setup ───
+    void setLatencyFrames(std::uint32_t frames);
+    double latencySeconds();
+
+    // ─── UI thread ───
+    // Pins `transportSeconds` to the next frame the mixer will render
+    void anchor(double transportSeconds);
+
+    double renderTime();    // transport time at the mixer's write position
+    double audibleTime();   // transport time of the sample currently being heard
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include "miniaudio.h"
+
+// Real-time mixer that feeds the playback device.
+//
+// Everything the audio callback touches is sized up front: the device runs
+// fixed-size periods of at most `maxBlockFrames`, and every TimelineTrack
+// owns a scratch buffer of that many frames (see TimelineTrack::prepareScratch).
+// The callback therefore never allocates, never locks, and only talks to a
+// decoder's seek path when the transport explicitly jumps. It walks the
+// published TrackSet, never Timeline::timelineTracks itself.
+namespace AudioEngine {
+    constexpr ma_uint32 outputChannels = 2;      // always mix to stereo
+    constexpr ma_uint32 sampleRate = 48000;
+    constexpr ma_uint32 periodFrames = 256;      // requested device period
+
+    // Largest block the mixer will ever process in one go. Callbacks larger
+    // than this are split into several blocks instead of growing buffers.
+    extern ma_uint32 maxBlockFrames;
+
+    bool init(ma_device& device);
+    void start(ma_device& device);
+    void shutdown(ma_device& device);
+
+    void dataCallback(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount);
+
+    // Mixes `frameCount` frames of every playing track into `out` (interleaved
+    // stereo, overwritten). The device callback is one caller; the offline
+    // renderer is the other, and must hold setOffline(true) while it does.
+    void render(float* out, ma_uint32 frameCount);
+
+    // True once every playing track has `frameCount` frames buffered (or
+    // reaches its end within them) and no seek is outstanding. Consumer side
+    // only, so it may adopt seeks the streamer has served.
+    bool tracksReady(ma_uint32 frameCount);
+
+    // While set the device plays silence and leaves the track rings alone, so
+    // another thread can be their sole consumer. Returns once any callback
+    // already inside the mixer has left it.
+    void setOffline(bool offline);
+}
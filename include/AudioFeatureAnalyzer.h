@@ -4,17 +4,22 @@
 #include <atomic>
 #include <cmath>
 #include <algorithm>
+#include "SimdKernels.h"
+#include "SpectralAnalyzer.h"
 
 class AudioFeatureAnalyzer
 {
 public:
     // ─────────────── constructor ───────────────
-    AudioFeatureAnalyzer(std::size_t bufferize = 512,
+    AudioFeatureAnalyzer(std::size_t bufferSize = 512,
 		float smoothingAlpha = 0.10f)
         : bufferSize(bufferSize),
-		smoothingAlpha(std::clamp(smoothingAlpha, 0.0f, 1.0f))
+		smoothingAlpha(std::clamp(smoothingAlpha, 0.0f, 1.0f)),
+        mono(std::max<std::size_t>(bufferSize, 1))
     {
         rawEnvelope.store(0.0f, std::memory_order_relaxed);
+        peakLevel.store(0.0f, std::memory_order_relaxed);
+        rmsLevel.store(0.0f, std::memory_order_relaxed);
         smoothedEnvelope.store(0.0f, std::memory_order_relaxed);
         zeroCrossings.store(0, std::memory_order_relaxed);
     }
@@ -24,39 +29,51 @@ public:
         std::size_t  numSamples,
         int          numChannels = 1)
     {
+        if (numSamples == 0)
+            return;
+
         float env = smoothedEnvelope.load(std::memory_order_relaxed);
-        int   zcr = 0;
-        float raw = 0.0f;
-        float prevS = samples[0 * numChannels];
+        std::size_t zcr = 0;
+        float peak = 0.0f;
+        float sumSq = 0.0f;
+        float prevS = samples[0];                        // mono (L channel)
 
-        for (std::size_t i = 0; i < numSamples; ++i)
+        /* work through the block in scratch-sized pieces of contiguous mono */
+        for (std::size_t done = 0; done < numSamples; )
         {
-            float s = samples[i * numChannels];          // mono (L channel)
+            std::size_t n = (std::min)(numSamples - done, mono.size());
+            SimdKernels::deinterleave(samples + done * numChannels, n,
+                static_cast<std::size_t>(numChannels), 0, mono.data());
 
             /* ── envelope ── */
-            float absS = std::fabs(s);
-            raw = absS;
-
-            env += smoothingAlpha * (absS - env);
+            env = SimdKernels::envelopeFollow(mono.data(), n, smoothingAlpha, env);
+            SimdKernels::peakAndSumSquares(mono.data(), n, peak, sumSq);
 
             /* ── ZCR ── */
-            if ((prevS >= 0.0f && s < 0.0f) ||
-                (prevS < 0.0f && s >= 0.0f))
-                ++zcr;
+            zcr += SimdKernels::signChanges(mono.data(), n, prevS);
+            prevS = mono[n - 1];
+
+            /* ── spectral features, one FFT per hop ── */
+            spectral.push(mono.data(), n);
 
-            prevS = s;
+            done += n;
         }
 
         /* publish results atomically */
-        rawEnvelope.store(raw, std::memory_order_relaxed);
+        rawEnvelope.store(std::fabs(prevS), std::memory_order_relaxed);
         smoothedEnvelope.store(env, std::memory_order_relaxed);
-        zeroCrossings.store(zcr, std::memory_order_relaxed);
+        peakLevel.store(peak, std::memory_order_relaxed);
+        rmsLevel.store(std::sqrt(sumSq / float(numSamples)), std::memory_order_relaxed);
+        zeroCrossings.store(static_cast<int>(zcr), std::memory_order_relaxed);
     }
 
     /* ─────────────── accessors for the GUI thread ─────────────── */
     float getRawEnvelope()      const { return rawEnvelope.load(); }
     float getSmoothedEnvelope() const { return smoothedEnvelope.load(); }
+    float getPeak()             const { return peakLevel.load(); }
+    float getRms()              const { return rmsLevel.load(); }
     int   getZeroCrossingRate() const { return zeroCrossings.load(); }
+    float getSpectralFeature(SpectralFeature f) const { return spectral.get(f); }
 
     void setSmoothingAlpha(float guiVal01, float sampleRate)
     {
@@ -74,6 +91,10 @@ public:
             1.0f - 1e-9f);
     }
 
+    // Raw one-pole coefficient, as passed to the constructor
+    float getSmoothingCoefficient() const { return smoothingAlpha; }
+    void setSmoothingCoefficient(float alpha) { smoothingAlpha = std::clamp(alpha, 0.0f, 1.0f); }
+
     float getSmoothingAlpha(float sampleRate) const
     {
         /* convert α  →  τ  →  GUI */
@@ -90,7 +111,13 @@ private:
     /* thread-safe state */
     std::atomic<float> rawEnvelope{};
     std::atomic<float> smoothedEnvelope{};
+    std::atomic<float> peakLevel{};
+    std::atomic<float> rmsLevel{};
 
     std::atomic<int>   zeroCrossings{};
     float smoothingAlpha = 0.10f;
+
+    std::vector<float> mono;    // deinterleaved scratch, sized once in the constructor
+
+    SpectralAnalyzer spectral;
 };
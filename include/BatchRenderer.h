@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "GeometryCache.h"
+
+// Instanced drawing of the shared unit meshes.
+//
+// Canvas submits one InstanceData per object; flush() uploads the whole pass
+// into a single streaming instance buffer and issues one glDrawElementsInstanced
+// per group of instances sharing a mesh, fill mode and line width. The vertex
+// shader reads the model matrix, colour, size and stroke per instance, so no
+// uniforms change between objects.
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec4 hsva;     // converted to RGB in the vertex shader
+    glm::vec2 size;
+    float     stroke;
+};
+
+namespace BatchRenderer {
+
+    struct Stats {
+        std::uint32_t drawCalls = 0;
+        std::uint32_t instances = 0;
+    };
+
+    // `lineWidth` is GL state, so it is part of the group rather than the instance
+    void submit(const UnitMesh& mesh, bool filled, float lineWidth, const InstanceData& instance);
+
+    // Draws everything submitted since the last flush. Opaque passes may be
+    // regrouped freely; `preserveOrder` only merges consecutive submissions
+    // that share a group, for back-to-front blending.
+    void flush(bool preserveOrder = false);
+
+    // Rolls this frame's counters over into lastFrameStats()
+    void beginFrame();
+    const Stats& lastFrameStats();
+
+    // Deletes the instance buffer; needs the context that created it
+    void shutdown();
+}
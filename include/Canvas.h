@@ -1,6 +1,7 @@
 #pragma once
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <cstdint>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
 #include <glm/glm.hpp>
@@ -8,6 +9,9 @@
 #include "Scene.h"
 #include "Shader.h"
 
+struct Scene;   // Scene.h includes this header
+class RenderBackend;
+
 namespace Canvas {
 	glm::vec3 c_center();
 
@@ -35,6 +39,11 @@ namespace Canvas {
 	extern GLuint fbo, colorTex, depthRbo;
 	void render();
 
+	// Draws `scene` at exactly width×height without touching ImGui or the
+	// selection. With no backend it uses GL and leaves the resolved
+	// single-sample FBO bound for reading; any other backend keeps the frame.
+	void renderOffscreen(const Scene* scene, int width, int height, RenderBackend* backend = nullptr);
+
 	extern std::shared_ptr<GraphicObject> selectedObject;
 
 	inline void setSelected(std::shared_ptr<GraphicObject> obj) {
@@ -49,6 +58,13 @@ namespace Canvas {
 
 	extern bool clicked;
 
+	// Per-frame counters for profiling
+	struct FrameStats {
+		std::uint32_t objects = 0;
+		std::uint32_t transformsRecomputed = 0;
+	};
+	const FrameStats& lastFrameStats();
+
 	void shutdown();
 	void recreate(int newW, int newH);
 	void onResize(int canvasW, int canvasH);
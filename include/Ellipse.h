@@ -11,36 +11,21 @@ public:
     // 'segments' = number of rim vertices (≥ 3).  Higher = smoother.
     EllipseObject(ObjectType ellipse, const std::string& id, int segments = 64);
     EllipseObject::EllipseObject(const std::shared_ptr<GraphicObject>& other, int count);
-    ~EllipseObject();
 
     // ── Size / radius ──────────────────────────────────────────────
-    // Returns full width/height (diameter) in world units
-    glm::vec3 getSize() const override;
-
-    // Sets full width & height
-    void setSize(const glm::vec3& size);
+    // Size is the full width/height (diameter) in world units
+    using GraphicObject::setSize;
     void setSize(float width, float height) { setSize({ width, height, 0.0f }); }
-    void setStroke(float stroke) override;
 
     // Convenience: set radii directly
     void setRadius(float rx, float ry);
-    void setFilled(bool filled) override;
 
     // Mesh smoothness
     void setSegments(int segments);
 
     // ── Rendering ─────────────────────────────────────────────────
-    void draw() override;
-    void cleanup();
+    const UnitMesh& getMesh() const override;
 
 private:
-    void initMesh();
-
-    glm::vec2 radii_{ 0.5f, 0.5f };   // (rx, ry)
     int        segments_{ 64 };           // rim vertex count
-    GLuint strokeEBO_ = 0;
-    GLsizei strokeIndexCount_ = 0;
-
-    unsigned int VAO_{ 0 }, VBO_{ 0 };
-    bool meshInitialized_{ false };
 };
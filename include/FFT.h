@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Radix-2 real FFT.
+//
+// A length-N real transform is computed as an N/2 complex FFT followed by a
+// split step, so it costs roughly half of a full complex transform. Twiddles,
+// the bit-reversal permutation and the split coefficients are all built once
+// in the constructor; forward() does no allocation and no trig.
+class RealFFT {
+public:
+    explicit RealFFT(std::size_t size = 1024);
+
+    std::size_t size() const { return n_; }
+    std::size_t bins() const { return n_ / 2 + 1; }
+
+    // in: n real samples. re/im: bins() values each (DC … Nyquist).
+    void forward(const float* in, float* re, float* im);
+
+private:
+    std::size_t n_;
+    std::size_t half_;
+
+    std::vector<std::size_t> bitrev_;   // permutation for the half-size complex FFT
+    std::vector<float> twRe_, twIm_;    // e^(-2πik/half), k < half/2
+    std::vector<float> splitRe_, splitIm_; // e^(-2πik/n), k ≤ half
+
+    std::vector<float> workRe_, workIm_;
+};
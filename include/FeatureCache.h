@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Mapping.h"
+
+class SidecarSource;
+
+// Per-file table of every AudioParameter sampled at a fixed hop.
+//
+// Row i holds the analyzer state after it has consumed frames [0, (i+1)·hop),
+// i.e. exactly what the live analyzer reports once the playhead reaches that
+// frame. Rows are immutable once built; the backing store is either a mapped
+// sidecar file or, if that could not be written, a heap copy.
+class FeatureTable {
+public:
+    FeatureTable(std::shared_ptr<const void> storage, const float* rows,
+        std::uint64_t rowCount, std::uint32_t hopFrames, float smoothingAlpha)
+        : storage_(std::move(storage)), rows_(rows), rowCount_(rowCount),
+        hopFrames_(hopFrames), smoothingAlpha_(smoothingAlpha) {}
+
+    std::uint64_t rowCount() const { return rowCount_; }
+    std::uint32_t hopFrames() const { return hopFrames_; }
+    float smoothingAlpha() const { return smoothingAlpha_; }
+
+    // O(1) lookup of `param` at a playhead position in track-local frames
+    float value(std::uint64_t playFrame, AudioParameter param) const {
+        std::uint64_t row = playFrame / hopFrames_;
+        row = row == 0 ? 0 : (std::min)(row - 1, rowCount_ - 1);
+        return rows_[row * stride + static_cast<std::size_t>(param)];
+    }
+
+    static constexpr std::size_t stride = static_cast<std::size_t>(AudioParameter::COUNT);
+
+private:
+    std::shared_ptr<const void> storage_;
+    const float* rows_;
+    std::uint64_t rowCount_;
+    std::uint32_t hopFrames_;
+    float smoothingAlpha_;
+};
+
+// Hand-off point between an analysis job and the track that asked for it.
+// The job fills `table` and then raises `ready`; readers check `ready` first.
+// A job that gives up raises `failed` instead. `progress` runs from 0 to 1.
+struct FeatureSlot {
+    std::shared_ptr<const FeatureTable> table;
+    std::atomic<bool> ready{ false };
+    std::atomic<bool> failed{ false };
+    std::atomic<float> progress{ 0.0f };
+};
+
+// Loader-time feature pre-analysis.
+//
+// A sidecar `<file>.ezfeat` is mapped if its header matches the file's hash
+// and the analysis settings; otherwise the file is read once on the
+// SidecarJobs pool (see SidecarReader), run through an offline
+// AudioFeatureAnalyzer hop by hop, and the sidecar is rewritten.
+namespace FeatureCache {
+    constexpr std::uint32_t hopFrames = 256;   // matches AudioEngine::periodFrames so ZCR agrees
+
+    // Queues analysis of `source` decoded at `sampleRate`, analysed with the
+    // given envelope smoothing. The returned slot becomes ready when done.
+    std::shared_ptr<FeatureSlot> request(std::shared_ptr<const SidecarSource> source,
+        std::uint32_t sampleRate, float smoothingAlpha);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include "Mapping.h"
+
+// One mixer block's worth of analysis, stamped with the track-local frame at
+// which the block ended. The audio thread pushes one per block into the
+// track's featureFrames ring; the render loop drains them all every frame so
+// trigger mappings see every block, not just the latest one.
+struct FeatureFrame {
+    std::uint64_t sampleFrame = 0;
+    float values[static_cast<std::size_t>(AudioParameter::COUNT)] = {};
+};
+
+// Blocks of 256 frames at 48 kHz: about 2.7 s of UI stall before frames drop
+constexpr std::size_t featureQueueFrames = 512;
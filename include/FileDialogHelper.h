@@ -4,5 +4,11 @@
 
 namespace FileDialogHelper {
     extern std::string lastDirectory;
+
+    // Raised by the File menu; process() opens the matching dialog
+    extern bool openProjectDialog;
+    extern bool saveProjectDialog;
+    extern bool exportJsonDialog;
+
     void process();
 }
\ No newline at end of file
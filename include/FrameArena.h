@@ -0,0 +1,104 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// Linear allocator for data that lives exactly one frame.
+//
+// allocate() bumps an offset; reset() rewinds it. If a frame outgrows the
+// current block a new one is chained on so earlier pointers stay valid, and the
+// next reset() folds everything into one block of the high-water size. After
+// the first few frames nothing on the render path touches the heap.
+class FrameArena {
+public:
+    explicit FrameArena(std::size_t initialBytes = 64 * 1024) {
+        addBlock(initialBytes);
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Uninitialised storage for `count` Ts; only for types without destructors
+    template <typename T>
+    T* allocate(std::size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "arena memory is never destroyed");
+        const std::size_t bytes = count * sizeof(T);
+
+        std::size_t offset = align(used_, alignof(T));
+        if (offset + bytes > blocks_.back().size) {
+            addBlock((std::max)(bytes + alignof(T), blocks_.back().size * 2));
+            offset = 0;
+        }
+        used_ = offset + bytes;
+        return reinterpret_cast<T*>(blocks_.back().data.get() + offset);
+    }
+
+    void reset() {
+        if (blocks_.size() > 1) {
+            std::size_t total = 0;
+            for (const auto& b : blocks_)
+                total += b.size;
+            blocks_.clear();
+            addBlock(total);
+        }
+        used_ = 0;
+    }
+
+    std::size_t capacity() const {
+        std::size_t total = 0;
+        for (const auto& b : blocks_)
+            total += b.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;   // new[] is max_align_t aligned
+        std::size_t size;
+    };
+
+    static std::size_t align(std::size_t offset, std::size_t alignment) {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+
+    void addBlock(std::size_t bytes) {
+        blocks_.push_back({ std::make_unique<std::byte[]>(bytes), bytes });
+        used_ = 0;
+    }
+
+    std::vector<Block> blocks_;
+    std::size_t used_ = 0;
+};
+
+// Stable LSD radix sort of `items` by a 32-bit key, one byte per pass.
+// `scratch` must hold `count` items; passes where every key shares the byte
+// are skipped. The sorted result always ends up back in `items`.
+template <typename T, typename KeyFn>
+void radixSort(T* items, T* scratch, std::size_t count, KeyFn key) {
+    static_assert(std::is_trivially_copyable_v<T>, "radixSort moves items with memcpy");
+
+    T* src = items;
+    T* dst = scratch;
+    for (int shift = 0; shift < 32; shift += 8) {
+        std::size_t histogram[257] = {};
+        for (std::size_t i = 0; i < count; ++i)
+            histogram[((key(src[i]) >> shift) & 0xFF) + 1]++;
+
+        if (count > 0 && histogram[((key(src[0]) >> shift) & 0xFF) + 1] == count)
+            continue;
+
+        for (int b = 0; b < 256; ++b)
+            histogram[b + 1] += histogram[b];
+        for (std::size_t i = 0; i < count; ++i)
+            dst[histogram[(key(src[i]) >> shift) & 0xFF]++] = src[i];
+        std::swap(src, dst);
+    }
+
+    if (src != items)
+        std::memcpy(items, src, count * sizeof(T));
+}
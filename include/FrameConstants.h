@@ -0,0 +1,28 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Per-frame constants shared by every shader program.
+//
+// Programs that declare `layout(std140) uniform FrameConstants` get the block
+// bound to `binding` when they link (see Shader::reflect), so one buffer upload
+// per frame reaches all of them without any per-program uniform calls.
+namespace FrameConstants {
+
+    constexpr const char* blockName = "FrameConstants";
+    constexpr GLuint binding = 0;
+
+    // Mirrors the GLSL block under std140: mat4s are four vec4 columns
+    struct Data {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 viewProjection;
+    };
+    static_assert(sizeof(Data) == 3 * 64, "FrameConstants must match the std140 layout");
+
+    void update(const glm::mat4& view, const glm::mat4& projection);
+
+    // Deletes the buffer; needs the context that created it
+    void shutdown();
+}
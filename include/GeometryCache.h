@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "GraphicObject.h"
+
+// Shared unit meshes for the primitive shapes.
+//
+// Every shape is tessellated once at unit size and uploaded once; objects only
+// hold a reference to the cached mesh. Size and stroke are not baked into the
+// vertices: the vertex shader scales `pos` by the instance size and moves
+// stroke vertices by the instance stroke, either along the axes (`offset`,
+// used by the inset rectangle and ellipse borders) or along the mitred edge
+// normal it derives from `prev`/`next` at the object's actual size (star and
+// triangle). Mapped Size and Stroke parameters therefore never touch GPU buffers.
+struct MeshVertex {
+    glm::vec2 pos;       // unit-size position
+    glm::vec2 uv;
+    glm::vec2 prev;      // neighbouring outline vertices, for the miter normal
+    glm::vec2 next;
+    glm::vec2 offset;    // axis-aligned displacement per unit of stroke
+    float     miter;     // displacement along the miter normal per unit of stroke
+};
+
+// One index range of a unit mesh
+struct MeshRange {
+    GLsizei first = 0;   // in indices
+    GLsizei count = 0;
+};
+
+struct UnitMesh {
+    // CPU copy; SoftwareRasterizer draws from it without any GL context
+    std::vector<MeshVertex>    vertices;
+    std::vector<std::uint32_t> indices;
+
+    GLenum    primitive = GL_TRIANGLES;
+    MeshRange fill;
+    MeshRange stroke;
+
+    // Created by GeometryCache::vertexArray() on the first GL draw. The VAO
+    // also carries the instance attributes; see BatchRenderer.
+    mutable GLuint VAO = 0, VBO = 0, EBO = 0;
+};
+
+namespace GeometryCache {
+    // Builds the mesh on first use; `segments` only matters for ellipses.
+    // The reference stays valid until shutdown().
+    const UnitMesh& get(ObjectType type, int segments = 0);
+
+    // Uploads the mesh on first call and returns its VAO; needs a GL context
+    GLuint vertexArray(const UnitMesh& mesh);
+
+    std::size_t meshCount();
+
+    // Drops every mesh; deletes the GL objects of those that were uploaded,
+    // which needs the context that created them
+    void shutdown();
+}
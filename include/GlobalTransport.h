@@ -8,10 +8,14 @@ namespace GlobalTransport {
     extern bool isLooping;
     extern float currentTime;
     extern float totalTime;
-    extern float playStartTime;
 
     void setLoop();
     extern void resetLoop();
 
+    // Starts the transport clock at currentTime
+    void play();
+    // Jumps to `seconds`, re-anchoring the clock and re-seeking playing tracks
+    void seek(float seconds);
+
     float render();
 }
\ No newline at end of file
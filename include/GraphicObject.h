@@ -6,64 +6,31 @@
 #include <memory>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
 #include "Animation.h"
 #include "AnimationInfo.h"
 #include "AnimationPoint.h"
+#include "ObjectStore.h"
 #include "ScenesPanel.h"
 
-// Supported primitive and custom object types
-enum class ObjectType : int {
-    Background = -1,
-    Line,
-    Rectangle,
-    Ellipse,
-    Triangle,
-    Star,
-    COUNT
-    //etc.
-};
-
-static constexpr const char* objectTypeNames[] = {
-    "Line",
-    "Rectangle",
-    "Ellipse",
-    "Triangle",
-    "Star"
-};
-
-enum class GraphicParameter : std::size_t {
-    Position=0, // y-mapped
-    ZPosition=1,
-    Rotation=2,
-    XY_Rotation=3, // y-mapped
-    Size=4, // y-mapped
-    Hue_Sat=5, // y-mapped
-    Brightness=6,
-    Alpha=7,
-	Stroke=8,
-    COUNT
-};
-
-// Transform component: position, rotation, scale
-struct Transform {
-    glm::vec3 position{ 0.0f };
-    glm::vec3 rotation{ 0.0f };  // Euler angles in degrees
-    glm::vec3 scale{ 1.0f };
-};
-
-// Material component: color, optional texture, opacity
-struct Material {
-    glm::vec4 color{ 1.0f };      // RGBA
-    std::string texturePath;    // empty if none
-    float opacity{ 1.0f };        // 0.0 = transparent, 1.0 = opaque
-};
+struct UnitMesh;
 
 // Base class for all graphic objects (Particle, Population, etc.)
+//
+// A facade over an ObjectStore handle: transform, material, shape and
+// animation state live in the store's dense columns, and only cold data (id,
+// texture path, the Animation lists) is kept here. The object owns its handle
+// and releases it on destruction.
 class GraphicObject {
 public:
     GraphicObject(ObjectType type, const std::string& id);
     GraphicObject(const std::shared_ptr<GraphicObject>& other, int count);
-    virtual ~GraphicObject() = default;
+    virtual ~GraphicObject();
+
+    GraphicObject(const GraphicObject&) = delete;
+    GraphicObject& operator=(const GraphicObject&) = delete;
+
+    ObjectHandle getHandle() const { return handle_; }
 
     // Identification
     const std::string& getId() const;
@@ -73,7 +40,7 @@ public:
     void setId(const char* newId);
 
     // Transform accessors
-    const Transform& getTransform() const;
+    const Transform& getTransform() const { return ObjectStore::columns().transform[row()]; }
 
     void setPosition(const glm::vec3& p);
     void setZPosition(float z);
@@ -83,9 +50,17 @@ public:
     // Uniform scaling helper
     void setScale(float uniformScale) { setScale(glm::vec3(uniformScale)); }
 
+    // translate · rotateZYX · scale, cached until the transform changes.
+    // Size is not part of it; it travels per instance to the shader.
+    const glm::mat4& getWorldMatrix() const { return ObjectStore::columns().world[row()]; }
+    bool isTransformDirty() const { return ObjectStore::columns().transformDirty[row()] != 0; }
+    // Recomputes the cached matrix if needed; returns whether it did
+    bool updateWorldMatrix();
+
     // Material accessors
-    const Material& getMaterial() const;
-    void setColor(const glm::vec4& col);
+    const Material& getMaterial() const { return ObjectStore::columns().material[row()]; }
+    void setHSVA(const glm::vec4& hsva);
+    const std::string& getTexture() const { return texturePath_; }
     void setTexture(const std::string& path);
     void setOpacity(float op);
 
@@ -109,10 +84,12 @@ public:
     // Lifecycle
     void update();
     void GraphicObject::updateYMappedParameter(int xyIndex, glm::vec2 value, bool isY);
-    virtual void draw() = 0;    // render via OpenGL/ImGui
+    virtual const UnitMesh& getMesh() const = 0;   // shared unit mesh Canvas instances
+    virtual float getLineWidth() const { return 1.0f; }
 
-    virtual glm::vec3 getSize() const = 0;
-    virtual void setSize(const glm::vec3& size) = 0;
+    // Full extent; ellipses and stars report their diameters
+    virtual glm::vec3 getSize() const;
+    virtual void setSize(const glm::vec3& size);
 
     void setLoopType(LoopType);
     const LoopType const getLoopType();
@@ -122,33 +99,27 @@ public:
     const unsigned int getNoMoreAnimations();
     const unsigned int getMapBools();
 
-    virtual void setFilled(bool filled) = 0;
-    bool isFilled() const { return filled_; }
-    virtual void setStroke(float stroke) = 0;
-    float getStroke() const { return stroke_; }
+    virtual void setFilled(bool filled);
+    bool isFilled() const { return ObjectStore::columns().shape[row()].filled; }
+    virtual void setStroke(float stroke);
+    float getStroke() const { return ObjectStore::columns().shape[row()].stroke; }
 
 protected:
+    std::uint32_t row() const { return ObjectStore::row(handle_); }
+    Transform& transform() { return ObjectStore::columns().transform[row()]; }
+    const Transform& transform() const { return ObjectStore::columns().transform[row()]; }
+    Material& material() { return ObjectStore::columns().material[row()]; }
+    const Material& material() const { return ObjectStore::columns().material[row()]; }
+    ShapeParams& shape() { return ObjectStore::columns().shape[row()]; }
+    const ShapeParams& shape() const { return ObjectStore::columns().shape[row()]; }
+    AnimationState& animationState() { return ObjectStore::columns().animation[row()]; }
+    const AnimationState& animationState() const { return ObjectStore::columns().animation[row()]; }
+    void markTransformDirty() { ObjectStore::columns().transformDirty[row()] = 1; }
+
+    ObjectHandle   handle_;
     std::string    id_;
     ObjectType     type_;
-    Transform      transform_;
-    Material       material_;
-
-    bool filled_ = true;
-    float stroke_ = 0.1f;
-
-    LoopType loopType_ = LoopType::Off;
-    std::array<std::size_t, static_cast<std::size_t>(GraphicParameter::COUNT)> animationIndices_{};
-    unsigned int noMoreAnimations_ = 0;
+    std::string    texturePath_;    // empty if none
 
     std::array<std::vector<std::shared_ptr<Animation>>, static_cast<std::size_t>(GraphicParameter::COUNT)> animations_;
-
-    unsigned int mapBools_ = 0;  // mapBools_ is a bitmask, where each bit represents a parameter
-    std::array<unsigned int, 4> isMapY_ = { 0 };
-    // isMapY_ is an array of bitmasks, where each bit represents if 
-    // parameters 0, 3, 4, or 5 are only X mapped, only Y mapped, or both
-    unsigned int newMapBools_ = 0;
-    // newMapValues_ is a bitmask that signals if values in mapValues have been updated, 
-    // and if they are, Animations are bypassed in favor of the new Map values
-    std::array<unsigned int, 4> isNewMapY_ = { 0 };
-    // isNewMapY_ is a bitmask, where each bit signals if the Y values of parameters 0, 3, 4, or 5 are updated
 };
\ No newline at end of file
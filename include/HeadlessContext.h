@@ -0,0 +1,14 @@
+#pragma once
+
+// OpenGL 3.3 core context with no visible window, for offline rendering.
+//
+// Built with EZVZ_WITH_EGL (CMake option EZVZ_HEADLESS_EGL) it asks EGL for a
+// surfaceless display first and a default-display pbuffer second, which works
+// on a GPU-less box with Mesa's llvmpipe and no X or Wayland server. Without
+// EGL it falls back to a hidden GLFW window, which still needs a display.
+// Canvas renders into its own FBOs, so the default framebuffer is never used.
+namespace HeadlessContext {
+    // Creates the context, makes it current and loads glad
+    bool create();
+    void destroy();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct TimelineTrack;
+
+// Off-thread audio import.
+//
+// Opening a decoder and asking it for the file's length can mean scanning a
+// whole MP3, so an import runs TimelineTrack::loadTrack on a worker pool; the
+// feature and waveform analyses it queues then run on the SidecarJobs pool. The
+// UI thread only ever sees a track once all of that is done: publish() moves
+// it into Timeline::timelineTracks in one step. Several imports run at once.
+namespace ImportJobs {
+    enum class Stage {
+        Queued,
+        Opening,      // decoder open and length probe, on an import worker
+        Analysing,    // waiting on FeatureCache and WaveformCache
+        Failed
+    };
+
+    struct Import {
+        std::string path;
+        std::string displayName;
+        float startTime = 0.0f;      // timeline seconds the track is placed at
+
+        std::atomic<Stage> stage{ Stage::Queued };
+        std::unique_ptr<TimelineTrack> track;   // the worker's until stage reaches Analysing
+
+        // 0 → 1 over the whole import
+        float progress() const;
+    };
+
+    // Queues `path`, to be placed at `startTime` seconds once loaded
+    void request(const std::string& path, float startTime);
+
+    // Main thread, once per frame: publishes finished tracks and drops failed imports
+    void publish();
+
+    // Imports not yet published, oldest first; main thread only
+    const std::vector<std::shared_ptr<Import>>& active();
+
+    // Stops the workers and frees tracks that were never published
+    void shutdown();
+}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Half-open intervals [start, end) with O(log n) point and range queries.
+//
+// Entries are kept sorted by start, and a max-end tree sits over them: every
+// node holds the largest end in its subtree. A query binary-searches the
+// entries that start early enough, then walks down the tree into only those
+// subtrees whose max end reaches the query, so it costs O(log n + matches)
+// however the intervals overlap.
+//
+// `id` is the caller's name for an entry (an index into its own vector) and
+// must be below the number of entries. update() moves one interval in place:
+// a dragged edge only shifts its entry past the neighbours it overtakes,
+// each step an O(log n) tree repair, so edits never pay for a full rebuild.
+class IntervalIndex {
+public:
+    struct Entry {
+        float start = 0.0f;
+        float end = 0.0f;
+        std::uint32_t id = 0;
+    };
+
+    static constexpr std::uint32_t none = 0xFFFFFFFFu;
+
+    void assign(std::vector<Entry> entries) {
+        entries_ = std::move(entries);
+        std::sort(entries_.begin(), entries_.end(), before);
+
+        position_.assign(entries_.size(), 0);
+        for (std::uint32_t p = 0; p < entries_.size(); ++p)
+            position_[entries_[p].id] = p;
+
+        base_ = 1;
+        while (base_ < entries_.size())
+            base_ <<= 1;
+        tree_.assign(2 * base_, lowest);
+        for (std::size_t p = 0; p < entries_.size(); ++p)
+            tree_[base_ + p] = entries_[p].end;
+        for (std::size_t node = base_ - 1; node > 0; --node)
+            tree_[node] = (std::max)(tree_[2 * node], tree_[2 * node + 1]);
+    }
+
+    void clear() { assign({}); }
+
+    std::size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    void update(std::uint32_t id, float start, float end) {
+        std::size_t p = position_[id];
+        entries_[p].start = start;
+        entries_[p].end = end;
+
+        while (p > 0 && before(entries_[p], entries_[p - 1])) {
+            swapEntries(p, p - 1);
+            --p;
+        }
+        while (p + 1 < entries_.size() && before(entries_[p + 1], entries_[p])) {
+            swapEntries(p, p + 1);
+            ++p;
+        }
+        refresh(p);
+    }
+
+    // Largest end of any interval; lowest() when empty
+    float maxEnd() const { return tree_.empty() ? lowest : tree_[1]; }
+
+    // Calls f(entry) for every interval containing t
+    template <typename F>
+    void stab(float t, F&& f) const {
+        const std::size_t count = std::upper_bound(entries_.begin(), entries_.end(), t,
+            [](float v, const Entry& e) { return v < e.start; }) - entries_.begin();
+        visit(1, 0, base_, count, t, false, f);
+    }
+
+    // Calls f(entry) for every interval overlapping [from, to)
+    template <typename F>
+    void overlapping(float from, float to, F&& f) const {
+        const std::size_t count = std::lower_bound(entries_.begin(), entries_.end(), to,
+            [](const Entry& e, float v) { return e.start < v; }) - entries_.begin();
+        visit(1, 0, base_, count, from, false, f);
+    }
+
+    // As overlapping(), but with both sides closed: an interval that only
+    // meets [from, to] at an edge counts, and so does an empty one inside it
+    template <typename F>
+    void touching(float from, float to, F&& f) const {
+        const std::size_t count = std::upper_bound(entries_.begin(), entries_.end(), to,
+            [](float v, const Entry& e) { return v < e.start; }) - entries_.begin();
+        visit(1, 0, base_, count, from, true, f);
+    }
+
+    // Id of the earliest interval starting after t, or `none`
+    std::uint32_t firstStartingAfter(float t) const {
+        auto it = std::upper_bound(entries_.begin(), entries_.end(), t,
+            [](float v, const Entry& e) { return v < e.start; });
+        return it == entries_.end() ? none : it->id;
+    }
+
+private:
+    static constexpr float lowest = std::numeric_limits<float>::lowest();
+
+    static bool before(const Entry& a, const Entry& b) {
+        return a.start < b.start || (a.start == b.start && a.id < b.id);
+    }
+
+    void swapEntries(std::size_t a, std::size_t b) {
+        std::swap(entries_[a], entries_[b]);
+        position_[entries_[a].id] = static_cast<std::uint32_t>(a);
+        position_[entries_[b].id] = static_cast<std::uint32_t>(b);
+        refresh(a);
+    }
+
+    void refresh(std::size_t p) {
+        std::size_t node = base_ + p;
+        tree_[node] = entries_[p].end;
+        for (node >>= 1; node > 0; node >>= 1)
+            tree_[node] = (std::max)(tree_[2 * node], tree_[2 * node + 1]);
+    }
+
+    // Entries [lo, hi) under `node`, restricted to the first `count`, whose end passes
+    // `after` (or reaches it, when `closed`)
+    template <typename F>
+    void visit(std::size_t node, std::size_t lo, std::size_t hi, std::size_t count, float after,
+        bool closed, F& f) const {
+        if (lo >= count || tree_[node] < after || (!closed && tree_[node] == after))
+            return;
+        if (hi - lo == 1) {
+            f(entries_[lo]);
+            return;
+        }
+        const std::size_t mid = (lo + hi) / 2;
+        visit(2 * node, lo, mid, count, after, closed, f);
+        visit(2 * node + 1, mid, hi, count, after, closed, f);
+    }
+
+    std::vector<Entry> entries_;          // sorted by (start, id)
+    std::vector<std::uint32_t> position_; // id -> index into entries_
+    std::vector<float> tree_;             // max end; leaves at base_
+    std::size_t base_ = 1;
+};
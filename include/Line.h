@@ -8,20 +8,10 @@ class LineObject : public GraphicObject {
 public:
     LineObject(ObjectType type, std::string& id);
     LineObject::LineObject(const std::shared_ptr<GraphicObject>& other, int count);
-    ~LineObject();
 
-    glm::vec3 getSize() const override;
-    void setSize(const glm::vec3& size);
-    void setStroke(float stroke) override;
+    // Size x = length, y = line width
     void setFilled(bool filled) override;
 
-    void draw() override;
-    void cleanup();
-
-private:
-    glm::vec2 size_{ 1.0f, 1.0f };  // x = length, y = unused
-
-    unsigned int VAO_{ 0 }, VBO_{ 0 };
-    void initMesh();
-    bool meshInitialized_{ false };
+    const UnitMesh& getMesh() const override;
+    float getLineWidth() const override;
 };
@@ -1,5 +1,6 @@
 ﻿#pragma once
 #include <algorithm>
+#include <cstdint>
 #include "GraphicObject.h"
 #include "Canvas.h"
 #include "imgui.h"
@@ -44,10 +45,26 @@ const std::string mapTypeNames[] = {
 	"Trigger"
 };
 
+// Bumped whenever a mapping is added or its settings are edited; each
+// track's compiled MappingTable rebuilds itself when this moves on.
+namespace MappingEpoch {
+	inline std::uint64_t current = 1;
+	inline void bump() { ++current; }
+}
+
 namespace MappingRanges {
 	const glm::vec2 inputRanges[] = {
 		{ 0.0f, 1.0f } //Envelope
 		, { 0.0f, 1.0f } //ZCR
+		, { 0.0f, 1.0f } //Spectral Centroid (fraction of Nyquist)
+		, { 0.0f, 1.0f } //Spectral Flatness
+		, { 0.0f, 1.0f } //Spectral Rolloff (fraction of Nyquist)
+		, { 0.0f, 1.0f } //Spectral Contrast (dB / 60)
+		, { 0.0f, 0.5f } //Spectral Bandwidth (fraction of Nyquist)
+		, { 0.0f, 1.0f } //Spectral Entropy
+		, { 0.0f, 1.0f } //Spectral Flux
+		, { 0.0f, 10.0f } //Spectral Skewness
+		, { 0.0f, 50.0f } //Spectral Kurtosis
 	};
 
 	inline const glm::vec2 outputRanges(GraphicParameter px, bool py, float& input_drag_speed_, float& output_drag_speed_) {
@@ -121,48 +138,6 @@ public:
 	const std::string& getMapTypeName() const { return mapTypeNames[static_cast<int>(map_type_)]; }
 
 	virtual void showMappingParametersUI() = 0;
-	virtual void mapParameter(float) = 0;
-
-	void updateMappedObject(float value) {
-		if (auto obj = mapped_object.lock()) {
-			static std::vector<std::string> parameters{
-				"Position",
-				"Z-Position",
-				"Rotation",
-				"XY-Rotation",
-				"Size",
-				"Hue/Sat.",
-				"Brightness",
-				"Alpha",
-				"Stroke"
-			};
-			std::cout << "Updating " << parameters[static_cast<size_t>(g_param_)] << "'s "
-				<< (g_param_y_ ? "Y" : "X") << " value to " << value << '\n';
-
-			switch (g_param_) {
-			case GraphicParameter::Position: [[fallthrough]];
-			case GraphicParameter::XY_Rotation: [[fallthrough]];
-			case GraphicParameter::Size: [[fallthrough]];
-			case GraphicParameter::Hue_Sat: {
-				glm::vec2 param_value = obj->getParameterValue(static_cast<int>(g_param_));
-
-				if (!g_param_y_)
-					param_value.x = value;
-				else
-					param_value.y = value;
-
-				obj->setParameter(static_cast<int>(g_param_), param_value);
-				break;
-			}
-			default: {
-				obj->setParameter(static_cast<int>(g_param_), { value, NULL });
-				break;
-			}
-			}
-
-			obj->setNewMapBools(static_cast<int>(g_param_), g_param_y_);
-		}
-	}
 
 	const bool& getGParamY() const { return g_param_y_; }
 	const AudioParameter& getAudioParameter() const { return a_param_; }
@@ -198,6 +173,7 @@ public:
 	{
 		ImGui::SetNextItemWidth(100.0f);
 		if (ImGui::DragFloat("##InputRange", &map_input_.x, input_drag_speed_, input_range_.x, input_range_.y)) {
+			MappingEpoch::bump();
 			if (map_input_.x > input_range_.y) {
 				map_input_.x = input_range_.y;
 			}
@@ -208,6 +184,7 @@ public:
 		ImGui::SameLine();
 		ImGui::SetNextItemWidth(100.0f);
 		if (ImGui::DragFloat("Input", &map_input_.y, input_drag_speed_, input_range_.x, input_range_.y)) {
+			MappingEpoch::bump();
 			if (map_input_.y > input_range_.y) {
 				map_input_.y = input_range_.y;
 			}
@@ -217,10 +194,12 @@ public:
 		}
 
 		ImGui::SetNextItemWidth(100.0f);
-		ImGui::DragFloat("##OutputRange", &map_output_.x, output_drag_speed_, output_range_.x, output_range_.y);
+		if (ImGui::DragFloat("##OutputRange", &map_output_.x, output_drag_speed_, output_range_.x, output_range_.y))
+			MappingEpoch::bump();
 		ImGui::SameLine();
 		ImGui::SetNextItemWidth(100.0f);
-		ImGui::DragFloat("Output", &map_output_.y, output_drag_speed_, output_range_.x, output_range_.y);
+		if (ImGui::DragFloat("Output", &map_output_.y, output_drag_speed_, output_range_.x, output_range_.y))
+			MappingEpoch::bump();
 		if (map_output_.x < output_range_.x) {
 			map_output_.x = output_range_.x;
 		}
@@ -236,21 +215,14 @@ public:
 		}
 	}
 
-	float convertValue(float value) const {
-		if(map_input_.y - map_input_.x == 0.0f) {
-			return map_output_.y; // Avoid division by zero
-		}
-		float percent = (value - map_input_.x) / (map_input_.y - map_input_.x);
-		return map_output_.x + percent * (map_output_.y - map_output_.x);
-	}
+	const glm::vec2& getInputMapping() const { return map_input_; }
+	const glm::vec2& getOutputMapping() const { return map_output_; }
 
-	void mapParameter(float value) override {
-		float min_input_ = std::min(map_input_.x, map_input_.y);
-		float max_input_ = std::max(map_input_.x, map_input_.y);
-		if (value >= min_input_ && value <= max_input_) {
-			float converted_value = convertValue(value);
-			updateMappedObject(converted_value);
-		}
+	// Restores ranges saved with a project
+	void setMapping(const glm::vec2& input, const glm::vec2& output) {
+		map_input_ = input;
+		map_output_ = output;
+		MappingEpoch::bump();
 	}
 
 private:
@@ -273,45 +245,30 @@ public:
 		threshold_ = input_range_.x;
 	}
 
-	void mapParameter(float value) override {
-		bool shouldTrigger = false;
-		if (isGreaterThan_) {
-			if (value >= threshold_) {
-				shouldTrigger = true;
-			}
-		}
-		else {
-			if (value <= threshold_)
-				shouldTrigger = true;
-		}
+	float getThreshold() const { return threshold_; }
+	bool isGreaterThan() const { return isGreaterThan_; }
+	void setThreshold(float threshold, bool greaterThan) {
+		threshold_ = threshold;
+		isGreaterThan_ = greaterThan;
+		MappingEpoch::bump();
+	}
+	std::size_t getAnimationIndex() const { return animation_index_; }
 
-		std::cout << "shouldTrigger = " << std::boolalpha << shouldTrigger << '\n';
-
-		if (shouldTrigger) {
-			std::cout << "should trigger now...\n";
-			if (!hasReachedThreshold_) {
-				hasReachedThreshold_ = true;
-				std::cout << "... if I've reached this threshold, which yes, I have\n";
-				if (auto obj = getMappedObject()) {
-					std::cout << "triggering animation = " << animation_index_ + 1 << '\n';
-					obj->getAnimations(static_cast<std::size_t>(getGraphicParameter()))[animation_index_]->trigger();
-				}
-			}
-		}
-		else {
-			hasReachedThreshold_ = false;
-		}
-	};
+	// Edge-detection state, carried across MappingTable recompiles
+	bool hasReachedThreshold() const { return hasReachedThreshold_; }
+	void setReachedThreshold(bool reached) { hasReachedThreshold_ = reached; }
 
 	void showMappingParametersUI() override
 	{
 		ImGui::SetNextItemWidth(100.0f);
-		ImGui::DragFloat("##Threshold", &threshold_, input_drag_speed_, input_range_.x, input_range_.y, "%.3f");
+		if (ImGui::DragFloat("##Threshold", &threshold_, input_drag_speed_, input_range_.x, input_range_.y, "%.3f"))
+			MappingEpoch::bump();
 
 		ImGui::SameLine();
 		const char* greater_than_label = isGreaterThan_ ? ">" : "<";
 		if(ImGui::Button(greater_than_label)) {
 			isGreaterThan_ = !isGreaterThan_;
+			MappingEpoch::bump();
 		}
 
 		ImGui::SameLine();
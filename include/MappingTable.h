@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Mapping.h"
+
+// A track's mappings flattened into structure-of-arrays form.
+//
+// compile() walks the Mapping objects once and copies out what evaluation
+// needs: source feature, the affine input → output transform, threshold and
+// edge state for triggers, and which object/parameter/lane to write. Entries
+// are sorted by (object, parameter) so each target is read and written once
+// per frame however many lanes are mapped onto it. Evaluation is then a flat
+// loop over plain floats; the Mapping objects are only touched again at the
+// next compile, which happens when MappingEpoch moves or a target disappears.
+class MappingTable {
+public:
+    using MappingLists = std::array<std::vector<std::shared_ptr<Mapping>>,
+        static_cast<std::size_t>(AudioParameter::COUNT)>;
+
+    bool needsCompile() const { return compiledEpoch_ != MappingEpoch::current || targetExpired_; }
+
+    // Drops mappings whose object is gone, then rebuilds every table
+    void compile(MappingLists& mappings);
+
+    bool hasSync() const { return !sync_.source.empty(); }
+    bool hasTriggers() const { return !trig_.source.empty(); }
+
+    // `values` holds one float per AudioParameter
+    void evaluateTriggers(const float* values);
+    void evaluateSync(const float* values);
+
+private:
+    // Resolves every target for this frame; flags a recompile if one expired
+    bool lockTargets();
+
+    struct SyncColumns {
+        std::vector<std::uint8_t>  source;    // AudioParameter index
+        std::vector<float>         inLo, inHi;
+        std::vector<float>         inBase;    // map_input_.x
+        std::vector<float>         outBase;   // output at inBase
+        std::vector<float>         scale;     // output span / input span
+        std::vector<std::uint32_t> target;    // index into targets_
+        std::vector<std::uint8_t>  param;     // GraphicParameter
+        std::vector<std::uint8_t>  lane;      // 0 = x, 1 = y
+        std::vector<float>         out;       // evaluation results
+        std::vector<std::uint8_t>  active;    // value fell inside the input range
+    } sync_;
+
+    struct TriggerColumns {
+        std::vector<std::uint8_t>  source;
+        std::vector<float>         sign;      // +1 for ">", −1 for "<"
+        std::vector<float>         signedThreshold;
+        std::vector<std::uint8_t>  reached;
+        std::vector<std::uint32_t> target;
+        std::vector<std::uint8_t>  param;
+        std::vector<std::uint32_t> animation;
+        std::vector<std::shared_ptr<TriggerMapping>> owner;   // where `reached` is written back
+    } trig_;
+
+    std::vector<std::weak_ptr<GraphicObject>> targets_;
+    std::vector<std::shared_ptr<GraphicObject>> locked_;   // per-frame, reserved once
+
+    std::uint64_t compiledEpoch_ = 0;
+    bool targetExpired_ = false;
+};
@@ -1,5 +1,8 @@
 ﻿#include "imgui.h"
 #include "Style.h"
+#include "FileDialogHelper.h"
+#include "OfflineRenderer.h"
+#include "PcmCache.h"
 
 void menuBar() {
     if (ImGui::BeginMainMenuBar())               // ← starts the main menu bar
@@ -7,7 +10,14 @@ void menuBar() {
         if (ImGui::BeginMenu("File"))            // ← a “File” dropdown
         {
             if (ImGui::MenuItem("New", "Ctrl+N")) { /* New action */ }
-            if (ImGui::MenuItem("Open...", "Ctrl+O")) { /* Open action */ }
+            if (ImGui::MenuItem("Open...", "Ctrl+O")) { FileDialogHelper::openProjectDialog = true; }
+            if (ImGui::MenuItem("Save As...", "Ctrl+S")) { FileDialogHelper::saveProjectDialog = true; }
+            if (ImGui::MenuItem("Export JSON...")) { FileDialogHelper::exportJsonDialog = true; }
+            ImGui::Separator();
+            if (ImGui::MenuItem("Render Video...")) {
+                // Whole timeline with the default settings; runs after this UI frame
+                OfflineRenderer::request(OfflineRenderer::Settings{});
+            }
             ImGui::Separator();
             if (ImGui::MenuItem("Exit")) { /* Exit action */ }
             ImGui::EndMenu();
@@ -20,6 +30,19 @@ void menuBar() {
             ImGui::EndMenu();
         }
 
+        if (ImGui::BeginMenu("Audio"))
+        {
+            // Both apply to tracks loaded from now on
+            bool inMemory = PcmCache::enabled;
+            if (ImGui::MenuItem("Decode Tracks Into Memory", nullptr, &inMemory)) { PcmCache::enabled = inMemory; }
+            bool int16 = PcmCache::format == PcmBuffer::Format::Int16;
+            if (ImGui::MenuItem("16-bit In-Memory Audio", nullptr, &int16, inMemory)) {
+                PcmCache::format = int16 ? PcmBuffer::Format::Int16 : PcmBuffer::Format::Float32;
+            }
+            ImGui::Text("Resident: %.1f MB", PcmCache::residentBytes() / (1024.0 * 1024.0));
+            ImGui::EndMenu();
+        }
+
         if (ImGui::BeginMenu("Style"))            
         {
             if (ImGui::MenuItem("Volcano")) { setStyle(StyleType::Volcano); }
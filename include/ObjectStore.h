@@ -0,0 +1,151 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+#include "AnimationPoint.h"
+
+// Supported primitive and custom object types
+enum class ObjectType : int {
+    Background = -1,
+    Line,
+    Rectangle,
+    Ellipse,
+    Triangle,
+    Star,
+    COUNT
+    //etc.
+};
+
+static constexpr const char* objectTypeNames[] = {
+    "Line",
+    "Rectangle",
+    "Ellipse",
+    "Triangle",
+    "Star"
+};
+
+enum class GraphicParameter : std::size_t {
+    Position=0, // y-mapped
+    ZPosition=1,
+    Rotation=2,
+    XY_Rotation=3, // y-mapped
+    Size=4, // y-mapped
+    Hue_Sat=5, // y-mapped
+    Brightness=6,
+    Alpha=7,
+	Stroke=8,
+    COUNT
+};
+
+// Transform component: position, rotation, scale
+struct Transform {
+    glm::vec3 position{ 0.0f };
+    glm::vec3 rotation{ 0.0f };  // Euler angles in degrees
+    glm::vec3 scale{ 1.0f };
+};
+
+// Material component: colour and opacity. The texture path is cold and stays
+// on the GraphicObject.
+struct Material {
+    glm::vec4 hsva{ 0.0f, 0.0f, 1.0f, 1.0f };   // hue, saturation, brightness, alpha; RGB is derived in the vertex shader
+    float opacity{ 1.0f };        // 0.0 = transparent, 1.0 = opaque
+};
+
+// Shape component. `size` is the full extent for every type (an ellipse's or
+// star's diameters, a line's length and width).
+struct ShapeParams {
+    glm::vec2 size{ 1.0f, 1.0f };
+    float stroke = 0.1f;
+    bool filled = true;
+};
+
+// Animation playback and mapping state. The Animation lists themselves are
+// edited by the UI and live on the GraphicObject.
+struct AnimationState {
+    std::array<std::size_t, static_cast<std::size_t>(GraphicParameter::COUNT)> indices{};
+    unsigned int noMoreAnimations = 0;
+    LoopType loopType = LoopType::Off;
+
+    unsigned int mapBools = 0;                   // one bit per parameter
+    std::array<unsigned int, 4> isMapY = { 0 };  // parameters 0, 3, 4, 5: 1 = X, 2 = Y, 3 = both
+    unsigned int newMapBools = 0;                // parameters written by a mapping this frame
+    std::array<unsigned int, 4> isNewMapY = { 0 };
+};
+
+// Stable name for an object in the ObjectStore. `index` picks a slot and
+// `generation` counts how often that slot has been reused, so a handle to a
+// destroyed object never silently refers to its successor.
+struct ObjectHandle {
+    static constexpr std::uint32_t invalidIndex = 0xFFFFFFFFu;
+
+    std::uint32_t index = invalidIndex;
+    std::uint32_t generation = 0;
+
+    bool operator==(const ObjectHandle& o) const { return index == o.index && generation == o.generation; }
+    bool operator!=(const ObjectHandle& o) const { return !(*this == o); }
+};
+
+// Per-frame object state in dense structure-of-arrays form.
+//
+// Every column holds one entry per live object, packed with no holes, so
+// passes over transforms, materials or animation state walk contiguous memory
+// instead of hopping between heap-allocated GraphicObjects. Handles go through
+// a slot table to their current row; destroying an object moves the last row
+// into its place and patches that row's slot. GraphicObject is a facade over a
+// handle, so nothing outside it needs to know about rows.
+//
+// Rows, and references into the columns, are only valid until the next
+// create() or destroy(). Main thread only.
+namespace ObjectStore {
+    struct Columns {
+        std::vector<ObjectType>     type;
+        std::vector<Transform>      transform;
+        std::vector<glm::mat4>      world;            // translate · rotateZYX · scale
+        std::vector<std::uint8_t>   transformDirty;
+        std::vector<Material>       material;
+        std::vector<ShapeParams>    shape;
+        std::vector<AnimationState> animation;
+        std::vector<std::uint32_t>  slot;             // owning slot, for moving rows
+    };
+
+    struct Slot {
+        std::uint32_t row = 0;
+        std::uint32_t generation = 0;
+        bool live = false;
+    };
+
+    struct Storage {
+        Columns columns;
+        std::vector<Slot> slots;
+        std::vector<std::uint32_t> freeSlots;
+    };
+
+    // Never destroyed: scenes holding objects are torn down during static
+    // destruction, in no particular order relative to this
+    inline Storage& storage() {
+        static Storage* s = new Storage();
+        return *s;
+    }
+
+    inline Columns& columns() { return storage().columns; }
+    inline std::size_t size() { return storage().columns.slot.size(); }
+
+    inline bool alive(ObjectHandle h) {
+        const auto& slots = storage().slots;
+        return h.index < slots.size() && slots[h.index].live && slots[h.index].generation == h.generation;
+    }
+
+    // Current row of a live handle
+    inline std::uint32_t row(ObjectHandle h) { return storage().slots[h.index].row; }
+
+    ObjectHandle create(ObjectType type);
+    void destroy(ObjectHandle h);
+
+    // Copies every component of `from` onto `to`, except the type
+    void copyComponents(ObjectHandle from, ObjectHandle to);
+}
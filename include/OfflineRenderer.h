@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+
+// Frame-accurate export of the timeline to a Y4M video and a WAV file.
+//
+// Time advances by exactly 1/fps per frame, never by the wall clock. Before
+// frame i is drawn the mixer is run, in the same fixed-size blocks the device
+// uses, up to sample floor(i * sampleRate / fps), so mappings and triggers see
+// precisely the audio that precedes the frame. Each frame is drawn through
+// Canvas::renderOffscreen into the MSAA FBO, read back through a pair of pixel
+// buffers, and converted to YUV 4:2:0 and written by a ThreadPool while the
+// GL thread moves on to the next frame. With `software` set the frames come
+// from a SoftwareRasterizer instead and no GL context is needed at all.
+//
+// The tracks are taken over from the playback device for the duration:
+// TrackStreamer keeps decoding, the calling thread becomes the rings' only
+// consumer and waits for the streamer instead of skipping late blocks.
+namespace OfflineRenderer {
+    struct Settings {
+        std::string videoPath = "ezvz-render.y4m";   // "-" streams the Y4M to stdout
+        std::string audioPath = "ezvz-render.wav";   // empty skips audio
+        int width = 1280;                            // rounded down to even for 4:2:0
+        int height = 720;
+        int fps = 60;
+        float start = 0.0f;                          // seconds
+        float end = -1.0f;                           // < 0 renders to the end of the timeline
+        unsigned int encodeThreads = 0;              // 0 = one per spare core
+        bool software = false;                       // rasterise on the CPU (see SoftwareRasterizer)
+        unsigned int rasterThreads = 0;              // 0 = one per spare core
+    };
+
+    // For GL, runs on the thread that owns the context, after Canvas::init and
+    // with the shader loaded. Leaves the transport stopped. False on I/O errors.
+    bool render(const Settings& settings);
+
+    // The menu queues a render; the main loop runs it between UI frames
+    void request(const Settings& settings);
+    bool takeRequest(Settings& settings);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// A whole file decoded into memory, interleaved, in page-aligned storage.
+// Immutable once filled; shared by every track playing the same file.
+class PcmBuffer {
+public:
+    enum class Format : std::uint8_t {
+        Float32,
+        Int16      // half the memory; converted back to float as it is read
+    };
+
+    static constexpr std::size_t pageBytes = 4096;
+
+    PcmBuffer(Format format, std::uint32_t channels, std::uint64_t frames);
+    ~PcmBuffer();
+
+    PcmBuffer(const PcmBuffer&) = delete;
+    PcmBuffer& operator=(const PcmBuffer&) = delete;
+
+    Format format() const { return format_; }
+    std::uint32_t channels() const { return channels_; }
+    std::uint64_t frameCount() const { return frames_; }
+    std::size_t bytes() const { return bytes_; }
+    bool valid() const { return data_ != nullptr; }
+
+    // Copies up to `frames` frames starting at `frame` into `out` as float;
+    // returns how many there were. Never allocates, so the mixer may call it.
+    std::uint64_t read(std::uint64_t frame, float* out, std::uint64_t frames) const;
+
+    // Filled once by PcmCache before the buffer is shared
+    void* data() { return data_; }
+    void setFrameCount(std::uint64_t frames) { frames_ = frames; }
+
+    // Last UI frame a playing track used this buffer; drives eviction
+    mutable std::atomic<std::uint64_t> lastUsed{ 0 };
+
+private:
+    Format format_;
+    std::uint32_t channels_;
+    std::uint64_t frames_;
+    std::size_t bytes_;
+    void* data_ = nullptr;
+};
+
+// Optional in-memory playback.
+//
+// With the mode on, TimelineTrack::loadTrack decodes the whole file once and
+// the mixer copies straight out of the buffer: no streaming, and a seek is
+// just a new read position. Buffers are keyed by file and decode settings,
+// so duplicated tracks share one. When the buffers together exceed
+// `budgetBytes`, update() evicts the least recently played ones whose tracks
+// are stopped and whose file is not still being imported; those tracks fall
+// back to streaming, and the memory is freed through TrackSet once the audio
+// side has let go of it.
+namespace PcmCache {
+    extern std::atomic<bool> enabled;
+    extern std::atomic<PcmBuffer::Format> format;
+    extern std::atomic<std::size_t> budgetBytes;
+
+    // Any thread. The shared buffer for `path` decoded at `sampleRate` into
+    // `channels`, decoding it if no other track has; null when the mode is
+    // off, the file would not fit the budget or it cannot be decoded.
+    std::shared_ptr<const PcmBuffer> acquire(const std::string& path, std::uint32_t sampleRate,
+        std::uint32_t channels);
+
+    // Bytes held by decoded buffers the cache knows about
+    std::size_t residentBytes();
+
+    // UI thread, once per frame: marks buffers in use and enforces the budget
+    void update();
+
+    // Drops the cache's references; tracks keep theirs
+    void shutdown();
+}
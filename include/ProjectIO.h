@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+// Saving and opening shows.
+//
+// A project file (`.ezvz`) is a little-endian binary image of the timeline:
+// a header listing a fixed set of tables, each a packed array of plain
+// records — scenes, objects, animations, points, paths, tracks, mappings —
+// plus one string blob. Records refer to each other by table index, never by
+// pointer, so the file needs no fix-ups. Opening maps it and walks each table
+// once to build the runtime objects; no parsing, no per-field allocation.
+//
+// Every table carries its record stride, so a later version can append
+// fields to a record and older builds still read the prefix they know.
+namespace ProjectIO {
+    constexpr const char* extension = ".ezvz";
+
+    // Writes Timeline::scenes and Timeline::timelineTracks to `path`
+    bool save(const std::string& path);
+
+    // Replaces the whole timeline with the project at `path`. Leaves the
+    // current timeline untouched if the file is missing or malformed. Tracks
+    // are reloaded from disk, so neither the audio callback nor the
+    // TrackStreamer may be touching the old ones while this runs.
+    bool load(const std::string& path);
+
+    // Human-readable dump of the current timeline, in the same order and with
+    // the same indices as the binary tables, for diffing projects
+    bool exportJson(const std::string& path);
+
+    // The File menu queues an open; the main loop runs it between UI frames
+    // once playback is quiesced
+    void requestLoad(const std::string& path);
+    bool takeLoadRequest(std::string& path);
+}
@@ -9,27 +9,11 @@ public:
     // id: unique identifier, size: width and height in world units
     RectangleObject(ObjectType rect, std::string& id);
     RectangleObject::RectangleObject(const std::shared_ptr<GraphicObject>& other, int count);
-    ~RectangleObject();
 
     // Size accessors
-    glm::vec3 getSize() const override;
-    void setSize(const glm::vec3& size);
+    using GraphicObject::setSize;
     void setSize(float width, float height);
 
-    // Render the rectangle
-    void draw() override;
-    void cleanup();
-
-    void setStroke(float) override;
-    void setFilled(bool filled) override;
-
-private:
-    glm::vec2 size_{ 1.0f, 1.0f };
-
-    // OpenGL resources (vertex array, buffers)
-    unsigned int VAO_{ 0 }, VBO_{ 0 }, EBO_{ 0 };
-
-    // Helper: initializes the mesh data (called on first draw)
-    void initMesh();
-    bool meshInitialized_{ false };
+    // Shared unit mesh, sized and stroked per instance
+    const UnitMesh& getMesh() const override;
 };
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include "BatchRenderer.h"
+
+// Fixed-function state for one flush; mirrors what the canvas passes set on GL
+struct PassState {
+    bool depthTest = true;       // GL_LESS against the frame's depth buffer
+    bool depthWrite = true;
+    bool wireframe = false;      // triangle edges only, like glPolygonMode(GL_LINE)
+    bool preserveOrder = false;  // draw in submission order (blended passes)
+};
+
+// Where Canvas sends a frame's draws.
+//
+// Canvas builds the halo, opaque and transparent passes the same way for
+// every backend; the backend only rasterises. The GL backend forwards to
+// BatchRenderer and the MSAA FBO, SoftwareRasterizer draws on the CPU. Both
+// blend with SRC_ALPHA / ONE_MINUS_SRC_ALPHA over 4x multisampling.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual void beginFrame(int width, int height, const glm::vec4& clearColor,
+        const glm::mat4& view, const glm::mat4& projection) = 0;
+    virtual void submit(const UnitMesh& mesh, bool filled, float lineWidth, const InstanceData& instance) = 0;
+    virtual void flush(const PassState& state) = 0;
+
+    // Resolves the samples; the frame can be read back after this
+    virtual void endFrame() = 0;
+};
@@ -4,6 +4,7 @@
 #include "imgui.h"
 #include "Canvas.h"
 #include "GraphicObject.h"
+#include "Trace.h"
 #include "Rectangle.h"
 
 struct Scene {
@@ -24,7 +25,7 @@ struct Scene {
 	float sceneLength() { return endTime - startTime; }
 
 	void resetObjectAnimations() {
-		std::cout << "Resetting object animations for scene\n";
+		TRACE_DEBUG("Resetting object animations for scene");
 		for (auto& obj : objects) {
 			obj->resetAnimations(true);
 		}
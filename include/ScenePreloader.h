@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+
+struct Scene;
+
+// Warms the scene playback is about to enter, so crossing the boundary does
+// not stall the first frame on work that would otherwise happen lazily there:
+// uploading each object's unit mesh, compiling its AnimationCurves, and
+// recompiling the MappingTables of the tracks that play during the scene.
+//
+// Starts `lookAheadMs` before the next scene begins and spreads the objects
+// over frames, `objectsPerFrame` at a time. Main thread, with the GL context
+// current.
+namespace ScenePreloader {
+    inline constexpr float lookAheadMs = 750.0f;
+    inline constexpr std::size_t objectsPerFrame = 32;
+
+    // Once per frame while playing, with the playhead in seconds
+    void update(float seconds);
+
+    // Everything at once; GlobalTransport calls it on play and seek
+    void warm(Scene& scene);
+
+    // Forgets the scene being warmed; call when the scene list is replaced
+    void reset();
+}
@@ -8,7 +8,4 @@ namespace ScenesPanel {
 
 	extern const std::vector<std::string> parameters;
 	void render();
-
-	glm::vec4 rgb2hsv(const glm::vec4& c);
-	glm::vec4 hsv2rgb(const glm::vec4& c);
 }
\ No newline at end of file
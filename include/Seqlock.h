@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer sequence lock for small trivially-copyable values.
+//
+// The writer never waits: it bumps the sequence to odd, stores the payload and
+// bumps it back to even. Readers copy the payload and retry if the sequence
+// was odd or changed underneath them. The payload is kept in relaxed atomic
+// words so concurrent reads are well-defined without locking the writer out.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock copies raw bytes");
+    static constexpr std::size_t wordCount = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+public:
+    Seqlock() { store(T{}); }
+
+    // ─────────────── writer (one thread only) ───────────────
+    void store(const T& value) {
+        std::uint64_t words[wordCount] = {};
+        std::memcpy(words, &value, sizeof(T));
+
+        const std::uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < wordCount; ++i)
+            data_[i].store(words[i], std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // ─────────────── readers ───────────────
+    T load() const {
+        std::uint64_t words[wordCount];
+        std::uint32_t before, after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < wordCount; ++i)
+                words[i] = data_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1u) || before != after);
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    std::atomic<std::uint32_t> seq_{ 0 };
+    std::atomic<std::uint64_t> data_[wordCount];
+};
@@ -1,11 +1,17 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <iostream>
 
+// Precomputed uniform location; resolve once with Shader::uniform()
+struct UniformHandle {
+    GLint location = -1;
+    bool valid() const { return location != -1; }
+};
 
 class Shader {
 public:
@@ -20,15 +26,30 @@ public:
     void bind()   const { glUseProgram(id); }
     void unbind() const { glUseProgram(0); }
 
+    // Looks `name` up in the table reflected at link time; no GL call
+    UniformHandle uniform(const char* name) const;
+
     // uniform setters
     void setUniformMat4(const char* name, const glm::mat4& mat) const;
+    void setUniformVec2(const char* name, const glm::vec2& vec) const;
     void setUniformVec4(const char* name, const glm::vec4& vec) const;
     void setUniformInt(const char* name, int value)         const;
     void setUniformFloat(const char* name, float value)      const;
 
+    // hot-path setters
+    void setUniformMat4(UniformHandle h, const glm::mat4& mat) const;
+    void setUniformVec2(UniformHandle h, const glm::vec2& vec) const;
+    void setUniformVec4(UniformHandle h, const glm::vec4& vec) const;
+    void setUniformInt(UniformHandle h, int value)         const;
+    void setUniformFloat(UniformHandle h, float value)      const;
+
 private:
     // helpers
     std::string  loadFile(const char* path)           const;
     GLuint       compileShader(const char* src, GLenum type) const;
-    GLint        getUniformLocation(const char* name) const;
-};
\ No newline at end of file
+    void         reflect();
+
+    // Active default-block uniforms by name; names that were asked for but
+    // don't exist are cached as -1 so they only warn once
+    mutable std::unordered_map<std::string, GLint> locations_;
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "miniaudio.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class PcmBuffer;
+
+// One audio file as the loader-time analyses see it.
+//
+// Every cache that derives a sidecar from a file (FeatureCache,
+// WaveformCache) needs it mapped and its content hash for the sidecar
+// header. A track load makes one source and hands it to each of them; the
+// first job to ask maps and hashes it, the others reuse the result. With
+// the in-memory mode on, the track's PcmBuffer rides along so the analyses
+// read it instead of decoding the file again.
+class SidecarSource {
+public:
+    explicit SidecarSource(std::string path, std::shared_ptr<const PcmBuffer> pcm = nullptr)
+        : path_(std::move(path)), pcm_(std::move(pcm)) {}
+
+    SidecarSource(const SidecarSource&) = delete;
+    SidecarSource& operator=(const SidecarSource&) = delete;
+
+    const std::string& path() const { return path_; }
+
+    // Decoded at the sample rate the track asked the analyses for; may be null
+    const std::shared_ptr<const PcmBuffer>& pcm() const { return pcm_; }
+
+    // Any thread. Maps and hashes the file on first call; false if it
+    // could not be opened.
+    bool prepare() const;
+
+    // Valid once prepare() has returned true
+    const MappedFile& audio() const { return audio_; }
+    std::uint64_t contentHash() const { return hash_; }
+
+private:
+    std::string path_;
+    std::shared_ptr<const PcmBuffer> pcm_;
+    mutable std::once_flag once_;
+    mutable MappedFile audio_;
+    mutable std::uint64_t hash_ = 0;
+    mutable bool opened_ = false;
+};
+
+// Float frames of a prepared source at `sampleRate`, read in order: copied
+// out of its PcmBuffer when it has one with the wanted channel count,
+// otherwise decoded from the mapping.
+class SidecarReader {
+public:
+    SidecarReader(const SidecarSource& source, std::uint32_t sampleRate, std::uint32_t channels);
+    ~SidecarReader();
+
+    SidecarReader(const SidecarReader&) = delete;
+    SidecarReader& operator=(const SidecarReader&) = delete;
+
+    bool valid() const { return pcm_ != nullptr || decoderInitialized_; }
+    std::uint32_t channels() const { return channels_; }
+
+    // Total frames, or 0 if the decoder cannot tell
+    std::uint64_t lengthFrames() const { return length_; }
+
+    // Fills up to `frames` frames of `out`; returns how many there were
+    std::uint64_t read(float* out, std::uint64_t frames);
+
+private:
+    const PcmBuffer* pcm_ = nullptr;
+    ma_decoder decoder_;
+    bool decoderInitialized_ = false;
+    std::uint32_t channels_ = 0;
+    std::uint64_t length_ = 0;
+    std::uint64_t position_ = 0;
+};
+
+// The worker pool and file handling the sidecar caches share.
+namespace SidecarJobs {
+    // FNV-1a over `size` bytes
+    std::uint64_t fnv1a(const std::uint8_t* data, std::size_t size);
+
+    // Writes header then body to `<path>.tmp` and renames it over `path`, so
+    // readers only ever see a complete file
+    bool write(const std::string& path, const void* header, std::size_t headerBytes,
+        const void* body, std::size_t bodyBytes);
+
+    // Queues `job` on the loader pool. If the pool shuts down before it
+    // runs, `dropped` is called instead.
+    void submit(std::function<void()> job, std::function<void()> dropped);
+
+    // Long jobs poll this and give up once it is raised
+    bool cancelled();
+
+    // Number of jobs queued or running
+    std::size_t pending();
+
+    // Queued jobs are dropped, running ones stop at their next check; waits
+    // for them and stops the workers
+    void shutdown();
+}
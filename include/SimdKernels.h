@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+// Vectorised inner loops for the per-track audio analysis.
+//
+// Every kernel has a scalar reference implementation and, where the target
+// allows it, SSE2 / AVX2 (x86) or NEON (AArch64) versions. The best set the
+// CPU supports is picked once at start-up; callers just use the free functions.
+// Vector versions agree with the scalar ones exactly for deinterleave and
+// signChanges, and to float rounding for the reductions.
+namespace SimdKernels {
+
+    enum class Isa { Scalar, SSE2, AVX2, NEON };
+
+    Isa activeIsa();
+    const char* isaName(Isa isa);
+
+    // Copies one channel of an interleaved buffer into a contiguous one.
+    void deinterleave(const float* in, std::size_t frames, std::size_t channels,
+        std::size_t channel, float* out);
+
+    // Largest |x| and the sum of x² over n samples (accumulated into peak/sumSq).
+    void peakAndSumSquares(const float* x, std::size_t n, float& peak, float& sumSq);
+
+    // One-pole follower on |x|:  y += alpha · (|x| − y),  starting from `state`.
+    // Returns the state after the last sample.
+    float envelopeFollow(const float* x, std::size_t n, float alpha, float state);
+
+    // Number of times the sign (x < 0) flips, with `prev` as the sample before x[0].
+    std::size_t signChanges(const float* x, std::size_t n, float prev);
+
+    // Reference implementations, always available
+    namespace scalar {
+        void deinterleave(const float* in, std::size_t frames, std::size_t channels,
+            std::size_t channel, float* out);
+        void peakAndSumSquares(const float* x, std::size_t n, float& peak, float& sumSq);
+        float envelopeFollow(const float* x, std::size_t n, float alpha, float state);
+        std::size_t signChanges(const float* x, std::size_t n, float prev);
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "RenderBackend.h"
+
+class WorkStealingPool;
+
+// CPU implementation of RenderBackend, for render farms and CI without a GPU.
+//
+// Instances go through the same maths as vertex.glsl; each flush then bins
+// the screen-space triangles into 64×64 pixel tiles and rasterises the tiles
+// in parallel on a WorkStealingPool. Coverage uses the standard 4x MSAA
+// sample positions, with a triangle's edge functions evaluated for all four
+// samples of a pixel in one SIMD register (SSE2 / NEON, scalar elsewhere).
+// Depth testing and SRC_ALPHA blending happen per sample into 8-bit storage,
+// and endFrame() averages the samples as the GL resolve blit does. Lines,
+// including wireframe edges, are rasterised as lineWidth-wide quads like
+// multisampled GL lines. The result matches the GL path to within rounding
+// and sub-pixel edge placement.
+//
+// Triangles with a vertex behind the camera are dropped rather than clipped;
+// the canvas camera never gets close enough for that to matter.
+class SoftwareRasterizer final : public RenderBackend {
+public:
+    explicit SoftwareRasterizer(unsigned int threads = 0);
+    ~SoftwareRasterizer() override;
+
+    void beginFrame(int width, int height, const glm::vec4& clearColor,
+        const glm::mat4& view, const glm::mat4& projection) override;
+    void submit(const UnitMesh& mesh, bool filled, float lineWidth, const InstanceData& instance) override;
+    void flush(const PassState& state) override;
+    void endFrame() override;
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    // Resolved RGBA8, rows bottom-up like glReadPixels; valid after endFrame()
+    const std::uint8_t* pixels() const { return resolved_.data(); }
+
+    struct Triangle;   // screen-space setup, defined in the .cpp
+
+private:
+    struct Submission {
+        const UnitMesh* mesh;
+        bool filled;
+        float lineWidth;
+        InstanceData instance;
+    };
+
+    void addSubmission(const Submission& s, bool wireframe);
+    void addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec4& color);
+    void addLine(const glm::vec3& a, const glm::vec3& b, float width, const glm::vec4& color);
+    void rasterizeTile(std::size_t tile, const PassState& state);
+    std::pair<std::size_t, std::size_t> bandSamples(std::size_t band) const;
+
+    int width_ = 0, height_ = 0;
+    int tilesX_ = 0, tilesY_ = 0;
+    glm::mat4 viewProjection_{ 1.0f };
+
+    std::vector<std::uint8_t> samples_;   // RGBA8 × 4 samples per pixel
+    std::vector<float> depth_;            // 4 per pixel
+    std::vector<std::uint8_t> resolved_;
+
+    std::vector<Submission> pending_;
+    std::vector<glm::vec4> window_;        // vertex stage output, reused per submission
+    std::vector<Triangle> triangles_;
+    std::vector<std::vector<std::uint32_t>> bins_;   // triangle indices per tile, in order
+    std::vector<std::uint32_t> activeTiles_;
+
+    std::unique_ptr<WorkStealingPool> pool_;
+};
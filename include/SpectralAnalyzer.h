@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "FFT.h"
+
+// Order matches AudioParameter::SpCentroid … AudioParameter::SpKurtosis
+enum class SpectralFeature : std::size_t {
+    Centroid = 0,
+    Flatness,
+    Rolloff,
+    Contrast,
+    Bandwidth,
+    Entropy,
+    Flux,
+    Skewness,
+    Kurtosis,
+    COUNT
+};
+
+// Hop-based STFT feature extractor.
+//
+// Samples are pushed from the audio thread; every `hop` samples the most
+// recent `fftSize` samples are Hann-windowed, transformed once, and every
+// SpectralFeature is derived from that single magnitude spectrum. Frequency-like
+// features are reported as a fraction of Nyquist so they sit in 0…1. All buffers
+// are allocated in the constructor, so push() is safe on the real-time thread.
+// Results are published through atomics for the GUI/mapping side.
+class SpectralAnalyzer {
+public:
+    SpectralAnalyzer(std::size_t fftSize = 1024, std::size_t hop = 512);
+
+    // ─────────────── analysis (call from audio thread) ───────────────
+    // `stride` lets interleaved buffers be read one channel at a time.
+    void push(const float* samples, std::size_t numSamples, std::size_t stride = 1);
+
+    /* ─────────────── accessors for the GUI thread ─────────────── */
+    float get(SpectralFeature f) const {
+        return features_[static_cast<std::size_t>(f)].load(std::memory_order_relaxed);
+    }
+
+    std::size_t fftSize() const { return fft_.size(); }
+    std::size_t hopSize() const { return hop_; }
+
+    // Computes every feature for one frame of fftSize samples into `out`.
+    // Used by push() and by offline analysis that walks a file hop by hop.
+    void analyzeFrame(const float* frame, float* out);
+
+private:
+    RealFFT fft_;
+    std::size_t hop_;
+
+    std::vector<float> window_;     // precomputed Hann window
+    std::vector<float> history_;    // circular buffer of the last fftSize samples
+    std::size_t writePos_ = 0;
+    std::size_t sinceHop_ = 0;
+
+    std::vector<float> frame_;      // windowed, unwrapped copy of history_
+    std::vector<float> re_, im_;
+    std::vector<float> mag_, prevMag_;
+
+    std::array<std::atomic<float>, static_cast<std::size_t>(SpectralFeature::COUNT)> features_{};
+};
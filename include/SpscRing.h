@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <type_traits>
+
+// Wait-free single-producer / single-consumer ring buffer.
+//
+// Indices grow monotonically and are masked on access, so the capacity is
+// always a power of two. allocate() must be called before the ring is shared
+// between threads; after that the producer only calls write()/push() and the
+// consumer only calls read()/pop()/discardTo().
+template <typename T>
+class SpscRing {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing stores raw copies");
+
+public:
+    void allocate(std::size_t minCapacity) {
+        std::size_t cap = 1;
+        while (cap < minCapacity) cap <<= 1;
+        buffer_.assign(cap, T{});
+        mask_ = cap - 1;
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const { return buffer_.size(); }
+
+    std::size_t readAvailable() const {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    std::size_t writeAvailable() const { return capacity() - readAvailable(); }
+
+    // Producer-side position; everything before it has been published
+    std::size_t writeIndex() const { return head_.load(std::memory_order_relaxed); }
+
+    // ─────────────── producer ───────────────
+    std::size_t write(const T* src, std::size_t count) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        count = (std::min)(count, capacity() - (head - tail));
+
+        const std::size_t start = head & mask_;
+        const std::size_t first = (std::min)(count, capacity() - start);
+        std::memcpy(buffer_.data() + start, src, first * sizeof(T));
+        std::memcpy(buffer_.data(), src + first, (count - first) * sizeof(T));
+
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    bool push(const T& value) { return write(&value, 1) == 1; }
+
+    // ─────────────── consumer ───────────────
+    std::size_t read(T* dst, std::size_t count) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        count = (std::min)(count, head - tail);
+
+        const std::size_t start = tail & mask_;
+        const std::size_t first = (std::min)(count, capacity() - start);
+        std::memcpy(dst, buffer_.data() + start, first * sizeof(T));
+        std::memcpy(dst + first, buffer_.data(), (count - first) * sizeof(T));
+
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    bool pop(T& value) { return read(&value, 1) == 1; }
+
+    // Drops everything before `index` (a value previously returned by
+    // writeIndex()). Never moves the read position backwards.
+    void discardTo(std::size_t index) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        if (index - tail <= head - tail)
+            tail_.store(index, std::memory_order_release);
+    }
+
+private:
+    std::vector<T> buffer_;
+    std::size_t mask_ = 0;
+
+    alignas(64) std::atomic<std::size_t> head_{ 0 };   // written by the producer
+    alignas(64) std::atomic<std::size_t> tail_{ 0 };   // written by the consumer
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// One thread per core, less one for the caller. hardware_concurrency() may
+// report 0 when the count is unknown, which must not wrap.
+inline unsigned int defaultWorkerCount() {
+    return (std::max)(2u, std::thread::hardware_concurrency()) - 1;
+}
+
+// Fixed set of worker threads draining a FIFO of jobs.
+//
+// Used for loader-time work (feature analysis, file hashing) that must stay
+// off both the UI and the audio thread. The destructor finishes queued jobs
+// before joining.
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned int threads = 0) {
+        if (threads == 0)
+            threads = defaultWorkerCount();
+        for (unsigned int i = 0; i < threads; ++i)
+            workers_.emplace_back([this] { workerLoop(); });
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        for (auto& w : workers_)
+            w.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        cv_.notify_one();
+    }
+
+    std::size_t threadCount() const { return workers_.size(); }
+
+private:
+    void workerLoop() {
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty())
+                    return;   // stopping and drained
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
@@ -29,5 +29,9 @@ namespace Timeline {
     void init(float screenWidth);
 
     extern std::shared_ptr<Scene> currentScene;
+
+    // Scene shown at `seconds` during playback; the last scene when none covers it
+    std::shared_ptr<Scene> sceneAt(float seconds);
+
     void render(float currentTime);
 }
\ No newline at end of file
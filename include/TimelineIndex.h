@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include "IntervalIndex.h"
+
+// Interval indexes over Timeline::scenes (in ms, like Scene) and the regions
+// of Timeline::timelineTracks (in seconds, like TimelineTrack), keyed by their
+// position in those vectors.
+//
+// Whoever adds, removes or reorders scenes or tracks calls scenesChanged() or
+// tracksChanged() and the index is rebuilt on the next query; whoever moves
+// one calls sceneMoved() or trackMoved() and only that entry is repaired. A
+// size mismatch also forces a rebuild, so a forgotten call costs a rebuild,
+// never a wrong answer about a scene that does not exist. Main thread only.
+namespace TimelineIndex {
+    void scenesChanged();
+    void tracksChanged();
+    void sceneMoved(std::size_t index);
+    void trackMoved(std::size_t index);
+
+    const IntervalIndex& scenes();
+    const IntervalIndex& tracks();
+
+    // Index of the scene playing at `ms`: the last one in Timeline::scenes
+    // that contains it, as the old per-frame scan picked. -1 when none does.
+    int sceneAt(float ms);
+
+    // Index of the first scene to start after `ms`; -1 when there is none
+    int nextSceneAfter(float ms);
+
+    // Where the last scene or track region ends, in ms; 0 when there are none
+    float endMs();
+}
@@ -8,7 +8,13 @@
 #include <memory>
 #include "miniaudio.h"
 #include "AudioFeatureAnalyzer.h"
+#include "FeatureCache.h"
+#include "FeatureFrame.h"
+#include "SpscRing.h"
+#include "WaveformCache.h"
 #include "Mapping.h"
+#include "MappingTable.h"
+#include "PcmCache.h"
 #include "imgui.h"
 
 struct TimelineTrack {
@@ -28,22 +34,63 @@ struct TimelineTrack {
     ImU32 labelColor = IM_COL32_WHITE;
     bool selected = false;
     bool dragging = false;
-    bool muted = false;
+    std::atomic<bool> muted{ false };   // read by the mixer
     float dragStartMouseX = 0.0f;
     float dragStartTrackX = 0.0f;
 
     bool hasPlayed = false;
     bool initialized = false;
 
-    ma_decoder decoder;
+    ma_decoder decoder;             // only touched by the TrackStreamer worker after load
     bool decoderInitialized = false;
     uint32_t channelCount = 2;
-    uint64_t nextFrame = 0;
+    uint64_t nextFrame = 0;         // owned by the audio thread
+    uint64_t totalFrames = 0;       // cached at load, never queried from the callback
 	float sampleRate = 48000.0f; // Default sample rate
-    bool playing = false;
+    std::atomic<bool> playing{ false };
+
+    // ─── Seek handshake (UI → streamer → audio thread) ───
+    // The UI bumps seekRequest; the streamer seeks the decoder, records where
+    // the new data starts in the ring and publishes seekServed; the callback
+    // then drops everything before seekFlushIndex.
+    std::atomic<uint64_t>    seekFrame{ 0 };
+    std::atomic<uint32_t>    seekRequest{ 0 };
+    std::atomic<uint32_t>    seekServed{ 0 };
+    std::atomic<std::size_t> seekFlushIndex{ 0 };
+    std::atomic<uint64_t>    seekServedFrame{ 0 };
+    uint32_t seekSeen = 0;          // audio thread's copy of seekServed
+
+    // ─── Streaming state ───
+    SpscRing<float> ring;           // decoded, interleaved samples ahead of the playhead
+    uint64_t decodeFrame = 0;       // streamer-owned decoder position
+    bool decodeEof = false;         // streamer-owned
+    std::atomic<uint32_t> underruns{ 0 };
+
+    // ─── In-memory mode (see PcmCache) ───
+    // While pcmView is set the mixer reads the whole decoded file from it and
+    // serves seeks itself; the streamer leaves the track alone. `pcm` keeps
+    // the buffer alive and is only touched by the UI thread once published.
+    std::shared_ptr<const PcmBuffer> pcm;
+    std::atomic<const PcmBuffer*> pcmView{ nullptr };
+    uint32_t pcmSeekSeen = 0;       // audio thread's copy of seekRequest
+
+    // Decode target for the mixer, sized once for AudioEngine::maxBlockFrames
+    std::vector<float> scratch;
 
     AudioFeatureAnalyzer analyzer;
 
+    // Pre-analysed features for the whole file, filled in by FeatureCache.
+    // Until it is ready getParamValue falls back to the live analyzer.
+    std::shared_ptr<FeatureSlot> features;
+    std::atomic<uint64_t> playheadFrame{ 0 };   // last frame handed to the mixer
+
+    // Min/max/RMS overview the timeline draws, filled in by WaveformCache
+    std::shared_ptr<WaveformSlot> waveform;
+
+    // Per-block features, audio thread → render loop (see FeatureFrame)
+    SpscRing<FeatureFrame> featureFrames;
+    std::atomic<uint32_t> droppedFeatureFrames{ 0 };
+
     std::atomic<float> currentEnvelope{ 0.0f };   // raw, per-block value
     std::atomic<float> smoothedEnvelope{ 0.0f };  // low-pass output
     float              smoothingAlpha = 0.10f;  // 0  1, higher = quicker response
@@ -51,11 +98,16 @@ struct TimelineTrack {
     float lastLocalTime = 0.0f;
 
 	std::array<std::vector<std::shared_ptr<Mapping>>, static_cast<int>(AudioParameter::COUNT)> mappings;
+    MappingTable mappingTable;      // compiled form of `mappings`, evaluated every frame
     
     bool loadTrack(const std::string& path);
     void playTrack(float);
     void stopTrack();
     void unloadTrack();
+    void prepareScratch(uint32_t maxFrames);
+    // Back to streaming; the caller hands the buffer to TrackSet::defer
+    void detachPcm();
+    float bufferedSeconds() const;
 
     void computeComplementaryColor();
 	float getParamValue(AudioParameter param) const;
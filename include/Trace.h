@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Binary trace logging for the render and audio paths.
+//
+// TRACE_ERROR / TRACE_INFO / TRACE_DEBUG / TRACE_VERBOSE take a string
+// literal with `{}` placeholders and up to four arguments (integers, floats,
+// bools, or C strings that outlive the program, e.g. literals and static
+// name tables). Levels above EZVZ_TRACE_LEVEL expand to nothing, arguments
+// included; release builds default to level 0, so every call disappears.
+//
+// An enabled call only stamps the time, copies the raw arguments into a
+// fixed-size event and pushes it onto the calling thread's own ring; it never
+// formats, locks or touches I/O. A background drainer merges the rings by
+// timestamp and formats the events into the trace file. Events that arrive
+// while a ring is full are counted and reported instead of blocking.
+#ifndef EZVZ_TRACE_LEVEL
+#ifdef NDEBUG
+#define EZVZ_TRACE_LEVEL 0
+#else
+#define EZVZ_TRACE_LEVEL 3
+#endif
+#endif
+
+namespace Trace {
+
+    enum class Level : std::uint8_t { Error = 1, Info = 2, Debug = 3, Verbose = 4 };
+
+    enum class ArgKind : std::uint8_t { None, Int, Uint, Float, Bool, Str };
+
+    union ArgValue {
+        std::int64_t  i;
+        std::uint64_t u;
+        double        f;
+        const char*   s;
+    };
+
+    struct Event {
+        std::uint64_t timeNs;
+        const char*   format;
+        ArgValue      args[4];
+        ArgKind       kinds[4];
+        std::uint32_t thread;
+        Level         level;
+    };
+
+    extern std::atomic<bool> enabled;
+
+    // Starts the drainer writing to `path`; until then events are discarded
+    void start(const std::string& path);
+    // Flushes what is left and stops the drainer
+    void stop();
+
+    void push(Event& e);   // fills time/thread and enqueues on this thread's ring
+
+    // Allocates the calling thread's ring up front. Otherwise that happens on
+    // the thread's first event, which real-time threads should avoid.
+    void registerThread();
+
+    // ─── argument encoding ───
+    template <typename T>
+    inline void encode(const T& v, ArgValue& value, ArgKind& kind) {
+        if constexpr (std::is_same_v<T, bool>) {
+            value.u = v ? 1 : 0;
+            kind = ArgKind::Bool;
+        }
+        else if constexpr (std::is_enum_v<T>) {
+            value.i = static_cast<std::int64_t>(v);
+            kind = ArgKind::Int;
+        }
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            value.i = v;
+            kind = ArgKind::Int;
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            value.u = v;
+            kind = ArgKind::Uint;
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            value.f = v;
+            kind = ArgKind::Float;
+        }
+        else {
+            static_assert(std::is_convertible_v<T, const char*>, "unsupported trace argument");
+            value.s = v;
+            kind = ArgKind::Str;
+        }
+    }
+
+    template <typename... Args>
+    inline void emit(Level level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= 4, "trace events carry at most four arguments");
+        if (!enabled.load(std::memory_order_relaxed))
+            return;
+
+        Event e;
+        e.format = format;
+        e.level = level;
+        for (auto& k : e.kinds) k = ArgKind::None;
+        std::size_t i = 0;
+        ((encode(args, e.args[i], e.kinds[i]), ++i), ...);
+        (void)i;
+        push(e);
+    }
+}
+
+#if EZVZ_TRACE_LEVEL >= 1
+#define TRACE_ERROR(...) ::Trace::emit(::Trace::Level::Error, __VA_ARGS__)
+#else
+#define TRACE_ERROR(...) ((void)0)
+#endif
+
+#if EZVZ_TRACE_LEVEL >= 2
+#define TRACE_INFO(...) ::Trace::emit(::Trace::Level::Info, __VA_ARGS__)
+#else
+#define TRACE_INFO(...) ((void)0)
+#endif
+
+#if EZVZ_TRACE_LEVEL >= 3
+#define TRACE_DEBUG(...) ::Trace::emit(::Trace::Level::Debug, __VA_ARGS__)
+#else
+#define TRACE_DEBUG(...) ((void)0)
+#endif
+
+#if EZVZ_TRACE_LEVEL >= 4
+#define TRACE_VERBOSE(...) ::Trace::emit(::Trace::Level::Verbose, __VA_ARGS__)
+#else
+#define TRACE_VERBOSE(...) ((void)0)
+#endif
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+struct TimelineTrack;
+
+// The set of tracks the audio side sees, published read-copy-update style.
+//
+// Timeline::timelineTracks belongs to the UI thread, which may grow or swap
+// it at any time. The mixer and the streamer instead walk an immutable
+// Snapshot of raw track pointers: the UI builds a new one and swaps a single
+// pointer, and a reader that enters afterwards sees the new set while one
+// already inside keeps the old. Each reader announces the epoch it entered
+// in; a replaced snapshot, and any tracks retired with it, are freed by the
+// UI thread only once every reader has been seen outside or in a later
+// epoch. Readers never lock, allocate or free.
+namespace TrackSet {
+    struct Snapshot {
+        std::vector<TimelineTrack*> tracks;
+    };
+
+    // One slot per reading thread; a slot may only be held by one thread at
+    // a time. The offline renderer mixes as `Mixer` while it owns the engine.
+    enum class Reader {
+        Mixer,
+        Streamer,
+        COUNT
+    };
+
+    // Pins the current snapshot for its lifetime
+    class Guard {
+    public:
+        explicit Guard(Reader reader);
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        const std::vector<TimelineTrack*>& tracks() const { return snapshot_->tracks; }
+
+    private:
+        Reader reader_;
+        const Snapshot* snapshot_;
+    };
+
+    // UI thread: publishes Timeline::timelineTracks as the new set. Tracks
+    // in `retired` have already left that list; they are unloaded and
+    // destroyed once no reader can still hold them.
+    void publish(std::vector<std::unique_ptr<TimelineTrack>> retired = {});
+
+    // UI thread: keeps `resource` alive until no reader can still be using a
+    // pointer to it loaded before this call
+    void defer(std::shared_ptr<const void> resource);
+
+    // UI thread, once per frame: frees what every reader has moved past
+    void reclaim();
+
+    // Frees everything retired; only once the device and streamer are stopped
+    void shutdown();
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <atomic>
+
+// Background decode stage between the TimelineTrack decoders and the mixer.
+//
+// A single worker thread owns every ma_decoder: it services seek requests and
+// keeps each playing track's ring buffer filled `lookAheadSeconds` ahead of
+// the playhead, always topping up the track closest to running dry first.
+// The audio callback only ever copies out of the rings.
+namespace TrackStreamer {
+    constexpr float maxLookAheadSeconds = 2.0f;   // ring capacity per track
+    constexpr unsigned int decodeChunkFrames = 4096;
+
+    extern std::atomic<float> lookAheadSeconds;
+
+    void start();
+    void stop();
+
+    // Nudges the worker after a seek/play request instead of waiting for its next poll
+    void wake();
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class SidecarSource;
+
+// One bucket of a waveform: the sample range and loudness of a run of frames
+// across all channels, quantised to a byte each
+struct WaveformPeak {
+    std::int8_t  min;   // floor(min · 127)
+    std::int8_t  max;   // ceil(max · 127)
+    std::uint8_t rms;   // ceil(rms · 255)
+};
+static_assert(sizeof(WaveformPeak) == 3, "peaks are stored packed");
+
+// Min/max/RMS mipmap of a whole file.
+//
+// Level 0 summarises `baseFrames` frames per bucket and every level above
+// halves the bucket count, so a view at any zoom finds a level whose buckets
+// are between one and two pixels' worth of audio and draws each pixel from
+// at most three of them. All levels together are under twice level 0. Peaks
+// are immutable once built; the backing store is either a mapped sidecar file
+// or, if that could not be written, a heap copy.
+class WaveformPyramid {
+public:
+    WaveformPyramid(std::shared_ptr<const void> storage, const WaveformPeak* peaks,
+        std::uint64_t frameCount, std::uint32_t levelCount)
+        : storage_(std::move(storage)), peaks_(peaks), frameCount_(frameCount) {
+        std::uint64_t offset = 0;
+        std::uint64_t count = bucketCount(frameCount);
+        for (std::uint32_t l = 0; l < levelCount; ++l) {
+            offsets_.push_back(offset);
+            counts_.push_back(count);
+            offset += count;
+            count = (count + 1) / 2;
+        }
+    }
+
+    static constexpr std::uint32_t baseFrames = 256;
+
+    // Buckets of level 0 for a file of `frames` frames; the total over every
+    // level is what the sidecar stores
+    static std::uint64_t bucketCount(std::uint64_t frames) { return (frames + baseFrames - 1) / baseFrames; }
+    static std::uint32_t levelsFor(std::uint64_t frames) {
+        std::uint32_t levels = 1;
+        for (std::uint64_t n = bucketCount(frames); n > 1; n = (n + 1) / 2)
+            ++levels;
+        return levels;
+    }
+    static std::uint64_t totalPeaks(std::uint64_t frames) {
+        std::uint64_t total = 0;
+        std::uint64_t n = bucketCount(frames);
+        for (std::uint32_t l = 0; l < levelsFor(frames); ++l, n = (n + 1) / 2)
+            total += n;
+        return total;
+    }
+
+    std::uint64_t frameCount() const { return frameCount_; }
+    std::uint32_t levelCount() const { return static_cast<std::uint32_t>(counts_.size()); }
+    std::uint64_t levelSize(std::uint32_t l) const { return counts_[l]; }
+    std::uint64_t levelFrames(std::uint32_t l) const { return std::uint64_t(baseFrames) << l; }
+    const WaveformPeak* level(std::uint32_t l) const { return peaks_ + offsets_[l]; }
+
+    // Coarsest level whose buckets are no wider than `framesPerPixel`
+    std::uint32_t levelFor(double framesPerPixel) const {
+        std::uint32_t l = 0;
+        while (l + 1 < levelCount() && double(levelFrames(l + 1)) <= framesPerPixel)
+            ++l;
+        return l;
+    }
+
+    // Combined peak of frames [from, to) read from level `l`; quiet outside the file
+    WaveformPeak range(std::uint32_t l, std::uint64_t from, std::uint64_t to) const {
+        const std::uint64_t frames = levelFrames(l);
+        const std::uint64_t n = counts_[l];
+        std::uint64_t b0 = from / frames;
+        std::uint64_t b1 = (to > from ? to - 1 : from) / frames + 1;
+        if (b0 >= n)
+            return { 0, 0, 0 };
+        if (b1 > n)
+            b1 = n;
+
+        const WaveformPeak* p = level(l);
+        WaveformPeak out = p[b0];
+        for (std::uint64_t b = b0 + 1; b < b1; ++b) {
+            out.min = p[b].min < out.min ? p[b].min : out.min;
+            out.max = p[b].max > out.max ? p[b].max : out.max;
+            out.rms = p[b].rms > out.rms ? p[b].rms : out.rms;
+        }
+        return out;
+    }
+
+private:
+    std::shared_ptr<const void> storage_;
+    const WaveformPeak* peaks_;
+    std::uint64_t frameCount_;
+    std::vector<std::uint64_t> offsets_;   // first peak of each level
+    std::vector<std::uint64_t> counts_;
+};
+
+// Hand-off point between a pyramid job and the track that asked for it.
+// The job fills `pyramid` and then raises `ready`; readers check `ready` first.
+// A job that gives up raises `failed` instead. `progress` runs from 0 to 1.
+struct WaveformSlot {
+    std::shared_ptr<const WaveformPyramid> pyramid;
+    std::atomic<bool> ready{ false };
+    std::atomic<bool> failed{ false };
+    std::atomic<float> progress{ 0.0f };
+};
+
+// Loader-time waveform overview, alongside FeatureCache.
+//
+// A sidecar `<file>.ezpk` is mapped if its header matches the file's hash and
+// the decode rate; otherwise the file is read once on the SidecarJobs pool
+// (see SidecarReader), level 0 is filled bucket by bucket, the levels above
+// are reduced from it and the sidecar is rewritten.
+namespace WaveformCache {
+    // Queues the pyramid of `source` decoded at `sampleRate`. The returned
+    // slot becomes ready when done.
+    std::shared_ptr<WaveformSlot> request(std::shared_ptr<const SidecarSource> source,
+        std::uint32_t sampleRate);
+}
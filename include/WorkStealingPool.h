@@ -0,0 +1,139 @@
+#pragma once
+
+#include "ThreadPool.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fork-join pool for loops whose iterations differ wildly in cost.
+//
+// run() deals the indices round-robin onto one deque per thread (the caller
+// gets one too and works alongside). Each thread pops from the back of its
+// own deque and, once that is empty, steals from the front of the others, so
+// a thread that drew the expensive items does not hold up the rest. Used for
+// the software rasteriser's tiles: a tile full of overlapping shapes costs
+// far more than an empty one, and which tiles those are changes every frame.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(unsigned int threads = 0) {
+        if (threads == 0)
+            threads = defaultWorkerCount();
+        queues_ = std::vector<Queue>(threads + 1);
+        for (unsigned int i = 0; i < threads; ++i)
+            workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeCv_.notify_all();
+        for (auto& w : workers_)
+            w.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Calls fn(i) for every i in [0, count) and returns once all have finished.
+    // Not reentrant: one run() at a time.
+    void run(std::size_t count, const std::function<void(std::size_t)>& fn) {
+        if (count == 0)
+            return;
+
+        for (std::size_t i = 0; i < count; ++i)
+            queues_[i % queues_.size()].items.push_back(i);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &fn;
+            busy_ = workers_.size();
+            ++generation_;
+        }
+        wakeCv_.notify_all();
+
+        drain(queues_.size() - 1, fn);
+
+        // A thread only leaves drain() once every queue is empty and its own
+        // items are done, so all workers idle means every item has finished
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCv_.wait(lock, [this] { return busy_ == 0; });
+        job_ = nullptr;
+    }
+
+    std::size_t threadCount() const { return workers_.size() + 1; }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::size_t> items;
+    };
+
+    bool take(std::size_t self, std::size_t& item) {
+        {
+            Queue& own = queues_[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.items.empty()) {
+                item = own.items.back();
+                own.items.pop_back();
+                return true;
+            }
+        }
+        for (std::size_t k = 1; k < queues_.size(); ++k) {
+            Queue& victim = queues_[(self + k) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.items.empty()) {
+                item = victim.items.front();
+                victim.items.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void drain(std::size_t self, const std::function<void(std::size_t)>& fn) {
+        std::size_t item;
+        while (take(self, item))
+            fn(item);
+    }
+
+    void workerLoop(std::size_t self) {
+        std::size_t seen = 0;
+        for (;;) {
+            const std::function<void(std::size_t)>* fn;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeCv_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_)
+                    return;
+                seen = generation_;
+                fn = job_;
+            }
+
+            drain(self, *fn);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --busy_;
+            }
+            doneCv_.notify_one();
+        }
+    }
+
+    std::vector<Queue> queues_;   // one per worker, the caller's last
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeCv_;
+    std::condition_variable doneCv_;
+    const std::function<void(std::size_t)>* job_ = nullptr;
+    std::size_t busy_ = 0;
+    std::size_t generation_ = 0;
+    bool stopping_ = false;
+};
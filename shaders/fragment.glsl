@@ -1,8 +1,8 @@
 // fragment.glsl
 #version 330 core
 in vec2 vUV;
-uniform vec4 uColor;
+in vec4 vColor;
 out vec4 FragColor;
 void main(){
-    FragColor = uColor;
+    FragColor = vColor;
 }
\ No newline at end of file
@@ -1,10 +1,59 @@
 // vertex.glsl
-uniform mat4 uModel;
-uniform mat4 uView;
-uniform mat4 uProjection;
+#version 330 core
+layout(std140) uniform FrameConstants {
+    mat4 uView;
+    mat4 uProjection;
+    mat4 uViewProjection;
+};
 
-layout(location = 0) in vec3 aPos;
+// Unit mesh (see GeometryCache.h)
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec2 aUV;
+layout(location = 2) in vec2 aPrev;
+layout(location = 3) in vec2 aNext;
+layout(location = 4) in vec2 aOffset;
+layout(location = 5) in float aMiter;
+
+// Per instance (see BatchRenderer.h)
+layout(location = 6) in mat4 iModel;
+layout(location = 10) in vec4 iHSVA;
+layout(location = 11) in vec3 iSizeStroke;
+
+out vec2 vUV;
+out vec4 vColor;
+
+vec2 safeNormalize(vec2 v) {
+    float len = length(v);
+    return len > 0.0 ? v / len : vec2(0.0);
+}
+
+vec2 perp(vec2 v) {
+    return vec2(-v.y, v.x);
+}
+
+// Colour is stored as HSVA; hue wraps
+vec3 hsv2rgb(vec3 c) {
+    vec3 k = clamp(abs(mod(c.x * 6.0 + vec3(0.0, 4.0, 2.0), 6.0) - 3.0) - 1.0, 0.0, 1.0);
+    return c.z * mix(vec3(1.0), k, c.y);
+}
 
 void main() {
-    gl_Position = uProjection * uView * uModel * vec4(aPos, 1.0);
+    vec2 size = iSizeStroke.xy;
+    float stroke = iSizeStroke.z;
+    vec2 base = aPos * size;
+
+    // Axis-aligned inset, never past the centre
+    vec2 p = base + aOffset * stroke;
+    p = sign(base) * max(sign(base) * p, vec2(0.0));
+
+    // Miter along the averaged normal of the edges at this size
+    if (aMiter != 0.0) {
+        vec2 n = perp(safeNormalize(base - aPrev * size))
+               + perp(safeNormalize(aNext * size - base));
+        p += safeNormalize(n) * aMiter * stroke;
+    }
+
+    vUV = aUV;
+    vColor = vec4(hsv2rgb(iHSVA.xyz), iHSVA.w);
+    gl_Position = uViewProjection * iModel * vec4(p, 0.0, 1.0);
 }
@@ -1,9 +1,10 @@
 ﻿#include "AnimationPoint.h"
 #include "Animation.h"
+#include "AnimationCurve.h"
 
 void Animation::resetAnimation() {
     // — reset playhead
-	std::cout << "Resetting animation\n";
+	TRACE_DEBUG("Resetting animation");
     pointsIndex_ = 0;
     loopCount = 0;
 
@@ -14,6 +15,8 @@ void Animation::resetAnimation() {
     totalElapsedTime_ = 0.f;
     easedElapsedTime_ = 0.f;
     totalWarpTime_ = 0.f;
+    curveCursor_ = 0;
+    hasBakedValue_ = false;
 
     originalStartPoint_ = GlobalTransport::currentTime * 1000.0f;
     startPoint_ = GlobalTransport::currentTime * 1000.0f;
@@ -58,10 +61,32 @@ Animation::Animation(const std::shared_ptr<Animation>& other) {
 
 void Animation::addPoint(std::shared_ptr<AnimationPoint>& newPoint) {
     points_.push_back(newPoint);
+    AnimationEpoch::bump();
+}
+
+void Animation::setTrigger(bool t) {
+    hasTrigger_ = t;
+    AnimationEpoch::bump();
+}
+
+const AnimationCurve* Animation::bakedCurve() {
+    if (curveEpoch_ != AnimationEpoch::current) {
+        curve_ = AnimationCurve::compile(*this);
+        curveEpoch_ = AnimationEpoch::current;
+        curveCursor_ = 0;
+    }
+    return curve_.get();
+}
+
+void Animation::setBakedValue(float t, glm::vec2 value, bool finished) {
+    hasBakedValue_ = true;
+    bakedTime_ = t;
+    bakedValue_ = value;
+    bakedFinished_ = finished;
 }
 
 void Animation::updatePointsIndex() {
-    std::cout << "Updating pointsIndex\n";
+    TRACE_VERBOSE("Updating pointsIndex");
     switch(animLoopType_){
     case LoopType::Off: {
         pointsIndex_++;
@@ -73,7 +98,7 @@ void Animation::updatePointsIndex() {
     }
     case LoopType::Sequence: {
         pointsIndex_++;
-        std::cout << "Updating pointsIndex through sequence\n";
+        TRACE_VERBOSE("Updating pointsIndex through sequence");
         if (pointsIndex_ >= points_.size()) {
             if (animLoopType_ == LoopType::Off) {
                 pointsIndex_ = points_.size() - 1;
@@ -83,7 +108,7 @@ void Animation::updatePointsIndex() {
             }
         }
         if (points_[pointsIndex_]->getLoopType() != LoopType::Off) {
-            std::cout << "Updating pointsIndex\n";
+            TRACE_VERBOSE("Updating pointsIndex");
             points_[pointsIndex_]->updatePathIndex();
         }
 
@@ -107,7 +132,7 @@ void Animation::updatePointsIndex() {
 
 void Animation::setElapsedTime(float t) {
     elapsedTime_ = t - startPoint_;
-    std::cout << " t: " << t << " - startPoint_: " << startPoint_ << " = elapsedTime_: " << elapsedTime_ << '\n';
+    TRACE_VERBOSE("t: {} - startPoint_: {} = elapsedTime_: {}", t, startPoint_, elapsedTime_);
 }
 
 glm::vec2 Animation::getValue(float t) {
@@ -115,6 +140,15 @@ glm::vec2 Animation::getValue(float t) {
     if (is_finished_)
         return curValue_;
 
+    // 1b) AnimationSystem already evaluated the baked curve for this frame
+    if (hasBakedValue_ && bakedTime_ == t) {
+        hasBakedValue_ = false;
+        curValue_ = bakedValue_;
+        is_finished_ = bakedFinished_;
+        return curValue_;
+    }
+    hasBakedValue_ = false;
+
     // 2) ease t and check totalElapsedTime_ against totalDuration_
     easedElapsedTime_ = getEasedTime(t);
 
@@ -125,9 +159,9 @@ glm::vec2 Animation::getValue(float t) {
     // 5) CASE A: Still “within” this point’s duration window
     if (easedElapsedTime_ < duration) {
         if (hasTrigger_) {
-            std::cout << "has trigger\n";
+            TRACE_VERBOSE("has trigger");
             if (isTriggered_) {
-                std::cout << "Trigger received for point " << pointsIndex_ << "\n";
+                TRACE_DEBUG("Trigger received for point {}", pointsIndex_);
                 isTriggered_ = false;
 
                 // If we just started, no need to advance index
@@ -180,7 +214,7 @@ glm::vec2 Animation::getValue(float t) {
         // In both cases, advance to the next index.
 
         updatePointsIndex();
-        std::cout << "is_finished = " << std::boolalpha << is_finished_ << '\n';
+        TRACE_VERBOSE("is_finished = {}", is_finished_);
         totalWarpTime_ += duration;
         startPoint_ = t;
         elapsedTime_ = 0.0f;
@@ -243,6 +277,7 @@ void Animation::setTotalDuration() {
     totalDuration_ = 0.000f;
     for (auto& p : points_) 
         totalDuration_ += p->getDuration();
+    AnimationEpoch::bump();
 }
 
 const LoopType const Animation::getLoopType() {
@@ -252,6 +287,7 @@ const LoopType const Animation::getLoopType() {
 void Animation::setLoopType(LoopType newType) {
     animLoopType_ = newType;
     pointsIndex_ = 0;
+    AnimationEpoch::bump();
 }
 
 const EasingType const Animation::getEasingType() {
@@ -260,6 +296,7 @@ const EasingType const Animation::getEasingType() {
 
 void Animation::setEasingType(EasingType newType) {
     animEaseType_ = newType;
+    AnimationEpoch::bump();
 }
 
 float Animation::getEasedTime(float t) {
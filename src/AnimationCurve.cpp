@@ -0,0 +1,277 @@
+#include "AnimationCurve.h"
+#include "Animation.h"
+#include "AnimationPoint.h"
+#include "AnimationPath.h"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define EZVZ_SIMD_X86 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define EZVZ_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+    // Every EasingType in Horner form c0 + u·(c1 + u·c2), split at u = ½.
+    // Rounds identically to AnimationPath::easingFunction and
+    // Animation::easingFunction.
+    void easingCoefficients(EasingType easing, float lo[3], float hi[3]) {
+        float l0 = 0.0f, l1 = 1.0f, l2 = 0.0f;
+        float h0 = 0.0f, h1 = 1.0f, h2 = 0.0f;
+        switch (easing) {
+        case EasingType::EaseIn:
+            l1 = h1 = 0.0f; l2 = h2 = 1.0f;
+            break;
+        case EasingType::EaseOut:
+            l1 = h1 = 2.0f; l2 = h2 = -1.0f;
+            break;
+        case EasingType::EaseInOut:
+            l1 = 0.0f; l2 = 2.0f;
+            h0 = -1.0f; h1 = 4.0f; h2 = -2.0f;
+            break;
+        default:
+            break;
+        }
+        lo[0] = l0; lo[1] = l1; lo[2] = l2;
+        hi[0] = h0; hi[1] = h1; hi[2] = h2;
+    }
+
+    inline float polynomial(const float c[3], float u) {
+        return c[0] + u * (c[1] + u * c[2]);
+    }
+
+    glm::vec2 evaluateSegment(const AnimationCurve::Segment& s, float w) {
+        const float u = (std::clamp)((w - s.start) * s.invDuration, 0.0f, 1.0f);
+        const float e = polynomial(u < 0.5f ? s.lo : s.hi, u);
+        return u >= 1.0f ? s.to : s.from + s.delta * e;
+    }
+}
+
+// ─── Compilation ─────────────────────────────────────────────────────────────
+
+std::shared_ptr<const AnimationCurve> AnimationCurve::compile(Animation& animation) {
+    if (animation.hasTrigger())
+        return nullptr;
+
+    const LoopType loop = animation.getLoopType();
+    const EasingType easing = animation.getEasingType();
+    if (loop == LoopType::Random)
+        return nullptr;
+    // Past the first lap getEasedTime feeds values above 1 to the easing,
+    // which only Linear leaves periodic
+    if (loop == LoopType::Sequence && easing != EasingType::Linear)
+        return nullptr;
+
+    const float total = animation.getTotalDuration();
+    if (!(total > 0.0f))
+        return nullptr;
+
+    auto curve = std::make_shared<AnimationCurve>();
+    curve->total_ = total;
+    curve->invTotal_ = 1.0f / total;
+    curve->loops_ = (loop == LoopType::Sequence);
+    curve->snap_ = (easing == EasingType::EaseOut || easing == EasingType::EaseInOut);
+    easingCoefficients(easing, curve->warpLo_, curve->warpHi_);
+
+    auto& points = animation.getPoints();
+    curve->segments_.reserve(points.size());
+
+    float start = 0.0f;
+    for (auto& point : points) {
+        const float duration = point->getDuration();
+        auto& paths = point->getPaths();
+        if (duration < 0.0f)
+            return nullptr;
+        // A Sequence animation steps the point's path on every lap
+        if (loop == LoopType::Sequence && point->getLoopType() != LoopType::Off && paths.size() > 1)
+            return nullptr;
+
+        // Zero-length points are skipped over by the interpreter too
+        if (duration > 0.0f) {
+            Segment s{};
+            s.start = start;
+            s.invDuration = 1.0f / duration;
+            if (paths.empty()) {
+                s.from = s.to = point->getValue();
+                s.delta = glm::vec2(0.0f);
+                easingCoefficients(EasingType::Linear, s.lo, s.hi);
+            }
+            else {
+                const auto& path = paths[(std::min)(point->getPathIndex(), paths.size() - 1)];
+                s.from = path->getStart();
+                s.to = path->getEnd();
+                s.delta = s.to - s.from;
+                easingCoefficients(path->getEasingType(), s.lo, s.hi);
+            }
+            curve->segments_.push_back(s);
+        }
+        start += duration;
+    }
+
+    // setTotalDuration() sums in the same order, so anything else is stale
+    if (curve->segments_.empty() || start != total)
+        return nullptr;
+
+    return curve;
+}
+
+// ─── Scalar evaluation ───────────────────────────────────────────────────────
+
+float AnimationCurve::warp(float elapsed, bool& finished) const {
+    const float norm = elapsed * invTotal_;
+    float eased = polynomial(norm < 0.5f ? warpLo_ : warpHi_, norm);
+    if (snap_ && eased > 0.999)
+        eased = 1.0f;
+
+    float w = (std::max)(eased * total_, 0.0f);
+    if (loops_) {
+        finished = false;
+        // w >= 0, so truncation is floor and avoids a libm call without SSE4.1
+        w -= float(std::int64_t(w * invTotal_)) * total_;
+        if (w >= total_)
+            w = 0.0f;
+    }
+    else {
+        finished = (w >= total_);
+    }
+    return w;
+}
+
+std::size_t AnimationCurve::locate(float w, std::size_t hint) const {
+    const std::size_t n = segments_.size();
+    auto contains = [&](std::size_t i) {
+        return segments_[i].start <= w && (i + 1 == n || w < segments_[i + 1].start);
+    };
+
+    // Frames mostly land in the same segment as last time, or the next one
+    if (hint < n && contains(hint))
+        return hint;
+    if (hint + 1 < n && contains(hint + 1))
+        return hint + 1;
+
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), w,
+        [](float value, const Segment& s) { return value < s.start; });
+    return it == segments_.begin() ? 0 : std::size_t(it - segments_.begin() - 1);
+}
+
+glm::vec2 AnimationCurve::sample(float elapsed, bool& finished, std::size_t& cursor) const {
+    const float w = warp(elapsed, finished);
+    if (finished)
+        return segments_.back().to;
+    cursor = locate(w, cursor);
+    return evaluateSegment(segments_[cursor], w);
+}
+
+// ─── Batch evaluation ────────────────────────────────────────────────────────
+
+void AnimationCurve::Batch::clear() {
+    jobs.clear();
+}
+
+void AnimationCurve::Batch::add(const AnimationCurve* curve, float elapsedMs, std::size_t* cursor) {
+    jobs.push_back({ curve, elapsedMs, cursor });
+}
+
+void AnimationCurve::Batch::evaluate() {
+    const std::size_t n = jobs.size();
+    values.resize(n);
+    finished.resize(n);
+
+    // Chunked so the lanes stay in L1 however many jobs there are
+    for (std::size_t base = 0; base < n; base += Lanes::size) {
+        const std::size_t count = (std::min)(Lanes::size, n - base);
+        const std::size_t padded = (count + 3) & ~std::size_t(3);
+        Lanes& l = lanes_;
+
+        // Warp and locate are per curve; copy each job's segment into the lanes
+        for (std::size_t i = 0; i < count; ++i) {
+            const Job& job = jobs[base + i];
+            const AnimationCurve& curve = *job.curve;
+            bool done = false;
+            const float w = curve.warp(job.elapsed, done);
+            finished[base + i] = done ? 1 : 0;
+
+            const Segment* s;
+            if (done) {
+                // u = (1 - 0) · 1 selects the final segment's end exactly
+                s = &curve.segments_.back();
+                l.w[i] = 1.0f;
+                l.start[i] = 0.0f;
+                l.invDuration[i] = 1.0f;
+            }
+            else {
+                *job.cursor = curve.locate(w, *job.cursor);
+                s = &curve.segments_[*job.cursor];
+                l.w[i] = w;
+                l.start[i] = s->start;
+                l.invDuration[i] = s->invDuration;
+            }
+            l.lo0[i] = s->lo[0]; l.lo1[i] = s->lo[1]; l.lo2[i] = s->lo[2];
+            l.hi0[i] = s->hi[0]; l.hi1[i] = s->hi[1]; l.hi2[i] = s->hi[2];
+            l.fromX[i] = s->from.x; l.fromY[i] = s->from.y;
+            l.deltaX[i] = s->delta.x; l.deltaY[i] = s->delta.y;
+            l.toX[i] = s->to.x; l.toY[i] = s->to.y;
+        }
+        // Padding lanes evaluate to zero and are never read back
+        for (std::size_t i = count; i < padded; ++i) {
+            l.w[i] = l.start[i] = l.invDuration[i] = 0.0f;
+            l.lo0[i] = l.lo1[i] = l.lo2[i] = l.hi0[i] = l.hi1[i] = l.hi2[i] = 0.0f;
+            l.fromX[i] = l.fromY[i] = l.deltaX[i] = l.deltaY[i] = l.toX[i] = l.toY[i] = 0.0f;
+        }
+
+        // Segment evaluation, four jobs at a time with no branches
+        for (std::size_t i = 0; i < padded; i += 4) {
+#if defined(EZVZ_SIMD_X86)
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            __m128 u = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(&l.w[i]), _mm_load_ps(&l.start[i])),
+                _mm_load_ps(&l.invDuration[i]));
+            u = _mm_min_ps(_mm_max_ps(u, zero), one);
+
+            const __m128 elo = _mm_add_ps(_mm_load_ps(&l.lo0[i]), _mm_mul_ps(u,
+                _mm_add_ps(_mm_load_ps(&l.lo1[i]), _mm_mul_ps(u, _mm_load_ps(&l.lo2[i])))));
+            const __m128 ehi = _mm_add_ps(_mm_load_ps(&l.hi0[i]), _mm_mul_ps(u,
+                _mm_add_ps(_mm_load_ps(&l.hi1[i]), _mm_mul_ps(u, _mm_load_ps(&l.hi2[i])))));
+            const __m128 low = _mm_cmplt_ps(u, _mm_set1_ps(0.5f));
+            const __m128 e = _mm_or_ps(_mm_and_ps(low, elo), _mm_andnot_ps(low, ehi));
+
+            const __m128 end = _mm_cmpge_ps(u, one);
+            const __m128 x = _mm_add_ps(_mm_load_ps(&l.fromX[i]), _mm_mul_ps(_mm_load_ps(&l.deltaX[i]), e));
+            const __m128 y = _mm_add_ps(_mm_load_ps(&l.fromY[i]), _mm_mul_ps(_mm_load_ps(&l.deltaY[i]), e));
+            _mm_store_ps(&l.x[i], _mm_or_ps(_mm_and_ps(end, _mm_load_ps(&l.toX[i])), _mm_andnot_ps(end, x)));
+            _mm_store_ps(&l.y[i], _mm_or_ps(_mm_and_ps(end, _mm_load_ps(&l.toY[i])), _mm_andnot_ps(end, y)));
+#elif defined(EZVZ_SIMD_NEON)
+            const float32x4_t one = vdupq_n_f32(1.0f);
+            float32x4_t u = vmulq_f32(vsubq_f32(vld1q_f32(&l.w[i]), vld1q_f32(&l.start[i])),
+                vld1q_f32(&l.invDuration[i]));
+            u = vminq_f32(vmaxq_f32(u, vdupq_n_f32(0.0f)), one);
+
+            const float32x4_t elo = vaddq_f32(vld1q_f32(&l.lo0[i]), vmulq_f32(u,
+                vaddq_f32(vld1q_f32(&l.lo1[i]), vmulq_f32(u, vld1q_f32(&l.lo2[i])))));
+            const float32x4_t ehi = vaddq_f32(vld1q_f32(&l.hi0[i]), vmulq_f32(u,
+                vaddq_f32(vld1q_f32(&l.hi1[i]), vmulq_f32(u, vld1q_f32(&l.hi2[i])))));
+            const float32x4_t e = vbslq_f32(vcltq_f32(u, vdupq_n_f32(0.5f)), elo, ehi);
+
+            const uint32x4_t end = vcgeq_f32(u, one);
+            const float32x4_t x = vaddq_f32(vld1q_f32(&l.fromX[i]), vmulq_f32(vld1q_f32(&l.deltaX[i]), e));
+            const float32x4_t y = vaddq_f32(vld1q_f32(&l.fromY[i]), vmulq_f32(vld1q_f32(&l.deltaY[i]), e));
+            vst1q_f32(&l.x[i], vbslq_f32(end, vld1q_f32(&l.toX[i]), x));
+            vst1q_f32(&l.y[i], vbslq_f32(end, vld1q_f32(&l.toY[i]), y));
+#else
+            for (std::size_t k = i; k < i + 4; ++k) {
+                const float u = (std::min)((std::max)((l.w[k] - l.start[k]) * l.invDuration[k], 0.0f), 1.0f);
+                const float e = u < 0.5f
+                    ? l.lo0[k] + u * (l.lo1[k] + u * l.lo2[k])
+                    : l.hi0[k] + u * (l.hi1[k] + u * l.hi2[k]);
+                l.x[k] = u >= 1.0f ? l.toX[k] : l.fromX[k] + l.deltaX[k] * e;
+                l.y[k] = u >= 1.0f ? l.toY[k] : l.fromY[k] + l.deltaY[k] * e;
+            }
+#endif
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+            values[base + i] = glm::vec2(l.x[i], l.y[i]);
+    }
+}
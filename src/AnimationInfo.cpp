@@ -159,21 +159,18 @@ namespace AnimationInfo {
 			return { size.x, size.y };
 		}
 		case GraphicParameter::Hue_Sat: { // Color (Hue/Saturation)
-			Material mat = Canvas::selectedObject->getMaterial();
-			glm::vec4 hsv = ScenesPanel::rgb2hsv(mat.color);
-			return { hsv.x, hsv.y };
+			const glm::vec4& hsva = Canvas::selectedObject->getMaterial().hsva;
+			return { hsva.x, hsva.y };
 		}
 		case GraphicParameter::Brightness: { // Brightness
 			float y = getNewY(0.5f);
-			Material mat = Canvas::selectedObject->getMaterial();
-			glm::vec4 hsv = ScenesPanel::rgb2hsv(mat.color);
-			return { hsv.z, y };
+			const glm::vec4& hsva = Canvas::selectedObject->getMaterial().hsva;
+			return { hsva.z, y };
 		}
 		case GraphicParameter::Alpha: { // Alpha
 			float y = getNewY(0.5f);
-			Material mat = Canvas::selectedObject->getMaterial();
-			glm::vec4 hsv = ScenesPanel::rgb2hsv(mat.color);
-			return { hsv.w, y };
+			const glm::vec4& hsva = Canvas::selectedObject->getMaterial().hsva;
+			return { hsva.w, y };
 		}
 		case GraphicParameter::Stroke: { // Stroke
 			float y = getNewY(0.5f);
@@ -212,24 +209,18 @@ namespace AnimationInfo {
 			break;
 		}
 		case GraphicParameter::Hue_Sat: { //Hue/Saturation
-			Material mat = Canvas::selectedObject->getMaterial();
-			glm::vec4 hsv = ScenesPanel::rgb2hsv(mat.color);
-			glm::vec4 newColor = ScenesPanel::hsv2rgb({ value, hsv.z, hsv.w });
-			Canvas::selectedObject->setColor(newColor);
+			glm::vec4 hsva = Canvas::selectedObject->getMaterial().hsva;
+			Canvas::selectedObject->setHSVA({ value, hsva.z, hsva.w });
 			break;
 		}
 		case GraphicParameter::Brightness: { //Brightness
-			Material mat = Canvas::selectedObject->getMaterial();
-			glm::vec4 hsv = ScenesPanel::rgb2hsv(mat.color);
-			glm::vec4 newColor = ScenesPanel::hsv2rgb({ hsv.x, hsv.y, value.x, hsv.w });
-			Canvas::selectedObject->setColor(newColor);
+			glm::vec4 hsva = Canvas::selectedObject->getMaterial().hsva;
+			Canvas::selectedObject->setHSVA({ hsva.x, hsva.y, value.x, hsva.w });
 			break;
 		}
 		case GraphicParameter::Alpha: { //Alpha
-			Material mat = Canvas::selectedObject->getMaterial();
-			glm::vec4 hsv = ScenesPanel::rgb2hsv(mat.color);
-			glm::vec4 newColor = ScenesPanel::hsv2rgb({ hsv.x, hsv.y, hsv.z, value.x });
-			Canvas::selectedObject->setColor(newColor);
+			glm::vec4 hsva = Canvas::selectedObject->getMaterial().hsva;
+			Canvas::selectedObject->setHSVA({ hsva.x, hsva.y, hsva.z, value.x });
 			break;
 		}
 		case GraphicParameter::Stroke: { //Stroke
@@ -760,7 +751,7 @@ namespace AnimationInfo {
 				Canvas::selectedObject->getAnimations(animation_index)[selectedAnimation]->addPoint(newPointPtr);
 				Canvas::selectedObject->getAnimations(animation_index)[selectedAnimation]->setTotalDuration();
 				int size = Canvas::selectedObject->getAnimations(animation_index)[selectedAnimation]->getPoints().size();
-				std::cout << "AnimationPoints size = " << size << '\n';
+				TRACE_DEBUG("AnimationPoints size = {}", size);
 			}
 		}
 
@@ -802,6 +793,7 @@ namespace AnimationInfo {
 						GraphicParameter gp = GraphicParameter(ScenesPanel::animPropIndex);
 						auto newMapping = std::make_shared<TriggerMapping>(Canvas::selectedObject, ap, gp, static_cast<std::size_t>(i), MapType::Trigger);
 						TrackFeatures::selectedTrack->mappings[MappingsWindow::audioIndex].push_back(newMapping);
+						MappingEpoch::bump();
 
 						Canvas::selectedObject->getAnimations(animation_index)[i]->setTrigger(true);
 
@@ -0,0 +1,55 @@
+#include "AnimationSystem.h"
+#include "Animation.h"
+#include "AnimationCurve.h"
+#include "GlobalTransport.h"
+#include "GraphicObject.h"
+#include "Scene.h"
+#include <vector>
+
+namespace {
+    // Kept between frames so nothing is reallocated
+    AnimationCurve::Batch batch;
+    std::vector<Animation*> owners;
+
+    void flush(float t) {
+        batch.evaluate();
+        for (std::size_t i = 0; i < owners.size(); ++i)
+            owners[i]->setBakedValue(t, batch.values[i], batch.finished[i] != 0);
+        batch.clear();
+        owners.clear();
+    }
+}
+
+void AnimationSystem::update(Scene& scene) {
+    const float t = GlobalTransport::currentTime * 1000.0f;
+
+    batch.clear();
+    owners.clear();
+    for (auto& obj : scene.objects) {
+        const auto& indices = obj->getAnimationIndices();
+        const unsigned int exhausted = obj->getNoMoreAnimations();
+        for (std::size_t parameter = 0; parameter < indices.size(); ++parameter) {
+            if ((exhausted & (1u << parameter)) != 0)
+                continue;
+            auto& animations = obj->getAnimations(parameter);
+            if (animations.empty())
+                continue;
+
+            Animation& animation = *animations[indices[parameter]];
+            if (animation.is_finished())
+                continue;
+            const AnimationCurve* curve = animation.bakedCurve();
+            if (!curve)
+                continue;
+
+            batch.add(curve, t - animation.getStartTime(), animation.bakedCursor());
+            owners.push_back(&animation);
+            if (owners.size() == AnimationCurve::Batch::chunk)
+                flush(t);
+        }
+    }
+    flush(t);
+
+    for (auto& obj : scene.objects)
+        obj->update();
+}
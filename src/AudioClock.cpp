@@ -0,0 +1,65 @@
+#include "AudioClock.h"
+#include "AudioEngine.h"
+#include "Seqlock.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+namespace AudioClock {
+
+    struct CallbackStamp {
+        std::uint64_t framesRendered;   // total frames written once this callback returns
+        double        hostSeconds;      // steady clock when the callback ran
+        std::uint32_t periodFrames;     // size of that callback
+    };
+
+    static Seqlock<CallbackStamp> stamp;
+    static std::uint64_t rendered = 0;                  // audio thread only
+    static std::atomic<std::uint32_t> latencyFrames{ 0 };
+
+    // UI-thread state: transport time `anchorSeconds` sits at frame `anchorFrame`
+    static double anchorSeconds = 0.0;
+    static std::uint64_t anchorFrame = 0;
+
+    static double hostNow() {
+        using namespace std::chrono;
+        return duration<double>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Frame the device is playing from the newest block, interpolated with the
+    // host clock and held at the end of that block until the next callback
+    static double playCursor(const CallbackStamp& s) {
+        double elapsed = (hostNow() - s.hostSeconds) * double(AudioEngine::sampleRate);
+        elapsed = std::clamp(elapsed, 0.0, double(s.periodFrames));
+        return double(s.framesRendered) - double(s.periodFrames) + elapsed;
+    }
+
+    void advance(std::uint32_t frameCount) {
+        rendered += frameCount;
+        stamp.store({ rendered, hostNow(), frameCount });
+    }
+
+    void setLatencyFrames(std::uint32_t frames) {
+        latencyFrames.store(frames, std::memory_order_relaxed);
+    }
+
+    double latencySeconds() {
+        return double(latencyFrames.load(std::memory_order_relaxed)) / double(AudioEngine::sampleRate);
+    }
+
+    void anchor(double transportSeconds) {
+        anchorSeconds = transportSeconds;
+        anchorFrame = stamp.load().framesRendered;
+    }
+
+    double renderTime() {
+        double frames = playCursor(stamp.load()) - double(anchorFrame);
+        return anchorSeconds + (std::max)(0.0, frames) / double(AudioEngine::sampleRate);
+    }
+
+    double audibleTime() {
+        double frames = playCursor(stamp.load()) - double(anchorFrame)
+            - double(latencyFrames.load(std::memory_order_relaxed));
+        return anchorSeconds + (std::max)(0.0, frames) / double(AudioEngine::sampleRate);
+    }
+}
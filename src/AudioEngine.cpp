@@ -0,0 +1,194 @@
+#include "AudioEngine.h"
+#include "AudioClock.h"
+#include "Timeline.h"
+#include "TimelineTrack.h"
+#include "TrackSet.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <iostream>
+
+namespace AudioEngine {
+
+    ma_uint32 maxBlockFrames = periodFrames;
+
+    static std::atomic<bool> offlineOwned{ false };
+    static std::atomic<bool> callbackMixing{ false };
+
+    // Drops the stale samples before a seek the streamer has finished.
+    // Returns false while the streamer is still on its way to the new position.
+    static bool adoptSeek(TimelineTrack& track) {
+        uint32_t served = track.seekServed.load(std::memory_order_acquire);
+        if (served != track.seekSeen) {
+            track.ring.discardTo(track.seekFlushIndex.load(std::memory_order_relaxed));
+            track.nextFrame = track.seekServedFrame.load(std::memory_order_relaxed);
+            track.seekSeen = served;
+        }
+        return track.seekRequest.load(std::memory_order_relaxed) == served;
+    }
+
+    // In memory a seek is just a new read position
+    static void adoptPcmSeek(TimelineTrack& track) {
+        uint32_t request = track.seekRequest.load(std::memory_order_acquire);
+        if (request != track.pcmSeekSeen) {
+            track.nextFrame = track.seekFrame.load(std::memory_order_relaxed);
+            track.pcmSeekSeen = request;
+        }
+    }
+
+    // Mixes one block of at most maxBlockFrames into `out` (interleaved stereo).
+    // Samples come from each track's ring; decoding happens on the TrackStreamer.
+    static void mixBlock(const std::vector<TimelineTrack*>& tracks, float* out, ma_uint32 frameCount) {
+        for (TimelineTrack* track : tracks) {
+            if (!track->decoderInitialized || !track->playing)
+                continue;
+
+            const uint32_t ch = track->channelCount;
+            float* tempBuf = track->scratch.data();
+            ma_uint64 framesRead = 0;
+
+            if (const PcmBuffer* pcm = track->pcmView.load(std::memory_order_acquire)) {
+                adoptPcmSeek(*track);
+                framesRead = pcm->read(track->nextFrame, tempBuf, frameCount);
+            }
+            else {
+                if (!adoptSeek(*track))
+                    continue;
+                framesRead = track->ring.read(tempBuf, std::size_t(frameCount) * ch) / ch;
+            }
+
+            if (framesRead < frameCount && track->nextFrame + framesRead < track->totalFrames)
+                track->underruns.fetch_add(1, std::memory_order_relaxed);
+
+            // Mix into output buffer (ALWAYS outputting stereo); muted tracks keep
+            // consuming so they stay in sync and keep driving their mappings
+            if (!track->muted) {
+                for (ma_uint64 f = 0; f < framesRead; ++f) {
+                    float L = tempBuf[f * ch + 0];
+                    float R = (ch > 1) ? tempBuf[f * ch + 1] : L;
+                    out[f * 2 + 0] += L;
+                    out[f * 2 + 1] += R;
+                }
+            }
+
+            // ─── Audio-feature extraction (envelope + ZCR) ──────────────────────
+            if (framesRead > 0) {
+                track->analyzer.analyze(tempBuf, static_cast<std::size_t>(framesRead), ch);
+                track->currentEnvelope.store(track->analyzer.getSmoothedEnvelope(),
+                    std::memory_order_relaxed);
+            }
+
+            // Advance playback pointer
+            track->nextFrame += framesRead;
+            track->playheadFrame.store(track->nextFrame, std::memory_order_relaxed);
+
+            // Hand the whole block's features to the render loop, stamped with its end
+            if (framesRead > 0) {
+                FeatureFrame frame;
+                frame.sampleFrame = track->nextFrame;
+                frame.values[static_cast<std::size_t>(AudioParameter::Envelope)] =
+                    track->analyzer.getSmoothedEnvelope();
+                frame.values[static_cast<std::size_t>(AudioParameter::ZCR)] =
+                    static_cast<float>(track->analyzer.getZeroCrossingRate());
+                for (std::size_t sp = 0; sp < static_cast<std::size_t>(SpectralFeature::COUNT); ++sp) {
+                    frame.values[static_cast<std::size_t>(AudioParameter::SpCentroid) + sp] =
+                        track->analyzer.getSpectralFeature(static_cast<SpectralFeature>(sp));
+                }
+                if (!track->featureFrames.push(frame))
+                    track->droppedFeatureFrames.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (track->nextFrame >= track->totalFrames) {
+                track->playing = false;
+            }
+        }
+    }
+
+    void render(float* out, ma_uint32 frameCount) {
+        std::memset(out, 0, frameCount * outputChannels * sizeof(float)); // Stereo, silence
+
+        TrackSet::Guard guard(TrackSet::Reader::Mixer);
+
+        // Split oversized requests so the per-track scratch never has to grow
+        ma_uint32 done = 0;
+        while (done < frameCount) {
+            ma_uint32 block = (std::min)(frameCount - done, maxBlockFrames);
+            mixBlock(guard.tracks(), out + done * outputChannels, block);
+            done += block;
+        }
+    }
+
+    void dataCallback(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount) {
+        float* out = static_cast<float*>(pOutput);
+
+        // Announce before checking, so setOffline() either sees us or we see it
+        callbackMixing.store(true);
+        if (offlineOwned.load())
+            std::memset(out, 0, frameCount * outputChannels * sizeof(float));
+        else
+            render(out, frameCount);
+        callbackMixing.store(false);
+
+        AudioClock::advance(frameCount);
+    }
+
+    bool tracksReady(ma_uint32 frameCount) {
+        TrackSet::Guard guard(TrackSet::Reader::Mixer);
+        for (TimelineTrack* track : guard.tracks()) {
+            if (!track->decoderInitialized || !track->playing || track->pcmView.load(std::memory_order_acquire))
+                continue;
+            if (!adoptSeek(*track))
+                return false;
+
+            uint64_t remaining = track->totalFrames > track->nextFrame ? track->totalFrames - track->nextFrame : 0;
+            std::size_t needed = std::size_t((std::min)(uint64_t(frameCount), remaining)) * track->channelCount;
+            if (track->ring.readAvailable() < needed)
+                return false;
+        }
+        return true;
+    }
+
+    void setOffline(bool offline) {
+        offlineOwned.store(offline);
+        while (offline && callbackMixing.load())
+            std::this_thread::yield();
+    }
+
+    bool init(ma_device& device) {
+        ma_device_config config = ma_device_config_init(ma_device_type_playback);
+        config.playback.format = ma_format_f32;
+        config.playback.channels = outputChannels;
+        config.sampleRate = sampleRate;
+        config.periodSizeInFrames = periodFrames;   // fixed-size callbacks of this length
+        config.dataCallback = dataCallback;
+        config.pUserData = nullptr;
+
+        if (ma_device_init(NULL, &config, &device) != MA_SUCCESS) {
+            std::cerr << "Device was unable to be initialized.\n";
+            return false;
+        }
+
+        maxBlockFrames = periodFrames;
+
+        // Everything queued inside the device counts as output latency
+        ma_uint32 queued = device.playback.internalPeriodSizeInFrames * device.playback.internalPeriods;
+        if (device.playback.internalSampleRate != 0 && device.playback.internalSampleRate != sampleRate)
+            queued = ma_uint32(ma_uint64(queued) * sampleRate / device.playback.internalSampleRate);
+        AudioClock::setLatencyFrames(queued);
+
+        // Tracks loaded before the device came up get their scratch sized now
+        for (auto& track : Timeline::timelineTracks)
+            track->prepareScratch(maxBlockFrames);
+
+        return true;
+    }
+
+    void start(ma_device& device) {
+        ma_device_start(&device);
+    }
+
+    void shutdown(ma_device& device) {
+        ma_device_uninit(&device);
+    }
+}
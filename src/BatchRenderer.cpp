@@ -0,0 +1,163 @@
+#include "BatchRenderer.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace BatchRenderer {
+
+    // Instance attribute locations; 0-5 are the unit mesh's vertex attributes
+    static constexpr GLuint modelLocation = 6;    // mat4 takes 6-9
+    static constexpr GLuint hsvaLocation = 10;
+    static constexpr GLuint sizeStrokeLocation = 11;
+
+    struct Item {
+        const UnitMesh* mesh;
+        float lineWidth;
+        bool filled;
+    };
+
+    struct Group {
+        const UnitMesh* mesh;
+        float lineWidth;
+        bool filled;
+        std::uint32_t first;   // into the uploaded instances
+        std::uint32_t count;
+    };
+
+    // Scratch reused across flushes, so steady-state frames don't allocate
+    static std::vector<Item> items;
+    static std::vector<InstanceData> submitted;
+    static std::vector<std::uint32_t> order;
+    static std::vector<InstanceData> upload;
+    static std::vector<Group> groups;
+
+    static GLuint instanceVBO = 0;
+    static std::size_t capacityBytes = 0;
+
+    static Stats current, last;
+
+    static bool sameGroup(const Item& a, const Item& b) {
+        return a.mesh == b.mesh && a.filled == b.filled && a.lineWidth == b.lineWidth;
+    }
+
+    void submit(const UnitMesh& mesh, bool filled, float lineWidth, const InstanceData& instance) {
+        items.push_back({ &mesh, lineWidth, filled });
+        submitted.push_back(instance);
+    }
+
+    // Orphans the buffer each time so the driver never waits on last frame's draws
+    static void uploadInstances() {
+        const std::size_t bytes = upload.size() * sizeof(InstanceData);
+
+        if (instanceVBO == 0)
+            glGenBuffers(1, &instanceVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+
+        if (bytes > capacityBytes)
+            capacityBytes = (std::max)(bytes, capacityBytes * 2);
+        glBufferData(GL_ARRAY_BUFFER, capacityBytes, nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, upload.data());
+    }
+
+    // Points the mesh VAO's instance attributes at this group's slice of the buffer
+    static void bindInstances(std::uint32_t first) {
+        const GLsizei stride = sizeof(InstanceData);
+        const std::size_t base = std::size_t(first) * sizeof(InstanceData);
+
+        for (GLuint column = 0; column < 4; ++column) {
+            GLuint location = modelLocation + column;
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                (void*)(base + offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+            glVertexAttribDivisor(location, 1);
+        }
+
+        glEnableVertexAttribArray(hsvaLocation);
+        glVertexAttribPointer(hsvaLocation, 4, GL_FLOAT, GL_FALSE, stride,
+            (void*)(base + offsetof(InstanceData, hsva)));
+        glVertexAttribDivisor(hsvaLocation, 1);
+
+        // size.xy and stroke are contiguous
+        glEnableVertexAttribArray(sizeStrokeLocation);
+        glVertexAttribPointer(sizeStrokeLocation, 3, GL_FLOAT, GL_FALSE, stride,
+            (void*)(base + offsetof(InstanceData, size)));
+        glVertexAttribDivisor(sizeStrokeLocation, 1);
+    }
+
+    void flush(bool preserveOrder) {
+        if (items.empty())
+            return;
+
+        order.resize(items.size());
+        std::iota(order.begin(), order.end(), 0u);
+        if (!preserveOrder) {
+            std::stable_sort(order.begin(), order.end(), [](std::uint32_t a, std::uint32_t b) {
+                const Item& x = items[a];
+                const Item& y = items[b];
+                if (x.mesh != y.mesh) return std::less<const UnitMesh*>()(x.mesh, y.mesh);
+                if (x.filled != y.filled) return x.filled < y.filled;
+                return x.lineWidth < y.lineWidth;
+            });
+        }
+
+        upload.clear();
+        groups.clear();
+        for (std::uint32_t index : order) {
+            const Item& item = items[index];
+            if (groups.empty() || !sameGroup(item, items[order[groups.back().first]]))
+                groups.push_back({ item.mesh, item.lineWidth, item.filled,
+                    static_cast<std::uint32_t>(upload.size()), 0 });
+            groups.back().count++;
+            upload.push_back(submitted[index]);
+        }
+
+        uploadInstances();
+
+        float lineWidth = 1.0f;
+        for (const Group& g : groups) {
+            const MeshRange& range = g.filled ? g.mesh->fill : g.mesh->stroke;
+
+            glBindVertexArray(GeometryCache::vertexArray(*g.mesh));
+            glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+            bindInstances(g.first);
+
+            if (g.lineWidth != lineWidth) {
+                glLineWidth(g.lineWidth);
+                lineWidth = g.lineWidth;
+            }
+
+            glDrawElementsInstanced(g.mesh->primitive, range.count, GL_UNSIGNED_INT,
+                (void*)(range.first * sizeof(std::uint32_t)), GLsizei(g.count));
+
+            current.drawCalls++;
+            current.instances += g.count;
+        }
+
+        glBindVertexArray(0);
+        if (lineWidth != 1.0f)
+            glLineWidth(1.0f);
+
+        items.clear();
+        submitted.clear();
+    }
+
+    void beginFrame() {
+        last = current;
+        current = Stats{};
+        TRACE_VERBOSE("batch: {} draw calls, {} instances", last.drawCalls, last.instances);
+    }
+
+    const Stats& lastFrameStats() {
+        return last;
+    }
+
+    void shutdown() {
+        if (instanceVBO) {
+            glDeleteBuffers(1, &instanceVBO);
+            instanceVBO = 0;
+            capacityBytes = 0;
+        }
+    }
+}
@@ -4,8 +4,16 @@
 #include "TrackFeatures.h"
 #include "Timeline.h"
 #include "GraphicObject.h"
+#include "ObjectStore.h"
 #include "Rectangle.h"
+#include "GeometryCache.h"
+#include "BatchRenderer.h"
+#include "FrameConstants.h"
+#include "FrameArena.h"
+#include "RenderBackend.h"
+#include "Trace.h"
 #include "Scene.h"
+#include <cstring>
 #include <iostream>
 #include <memory>
 
@@ -219,7 +227,8 @@ namespace Canvas {
         currentH = h;
     }
 
-    void shutdown() {
+    // FBOs and the quad; the shared mesh and batch state survive a resize
+    static void releaseTargets() {
         if (quadVAO) {
             GLuint vbo = 0;
             glBindVertexArray(quadVAO);
@@ -239,10 +248,17 @@ namespace Canvas {
         glDeleteFramebuffers(1, &fbo);
     }
 
+    void shutdown() {
+        BatchRenderer::shutdown();
+        GeometryCache::shutdown();
+        FrameConstants::shutdown();
+        releaseTargets();
+    }
+
     void recreate(int newW, int newH) {
         if (newW == currentW && newH == currentH) return;
 
-        shutdown();
+        releaseTargets();
 
         glGenFramebuffers(1, &msFbo);
         glBindFramebuffer(GL_FRAMEBUFFER, msFbo);
@@ -254,7 +270,7 @@ namespace Canvas {
             GL_RENDERBUFFER,
             4,               // samples
             GL_RGBA8,
-            w, h
+            newW, newH
         );
         glFramebufferRenderbuffer(
             GL_FRAMEBUFFER,
@@ -270,7 +286,7 @@ namespace Canvas {
             GL_RENDERBUFFER,
             4,
             GL_DEPTH24_STENCIL8,
-            w, h
+            newW, newH
         );
         glFramebufferRenderbuffer(
             GL_FRAMEBUFFER,
@@ -287,7 +303,7 @@ namespace Canvas {
         glGenTextures(1, &colorTex);
         glBindTexture(GL_TEXTURE_2D, colorTex);
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8,
-            w, h,
+            newW, newH,
             0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -297,7 +313,7 @@ namespace Canvas {
         glBindRenderbuffer(GL_RENDERBUFFER, depthRbo);
         glRenderbufferStorage(GL_RENDERBUFFER,
             GL_DEPTH24_STENCIL8,
-            w, h);
+            newW, newH);
 
         // 3) Framebuffer
         glGenFramebuffers(1, &fbo);
@@ -320,7 +336,7 @@ namespace Canvas {
         // 6) Check completeness
         GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
         if (status != GL_FRAMEBUFFER_COMPLETE) {
-            std::cerr << "Canvas FBO not complete in init(): 0x"
+            std::cerr << "Canvas FBO not complete in recreate(): 0x"
                 << std::hex << status << std::dec << "\n";
         }
 
@@ -348,8 +364,8 @@ namespace Canvas {
             glBindVertexArray(0);
         }
 
-        currentW = w;
-        currentH = h;
+        currentW = newW;
+        currentH = newH;
     }
 
     glm::vec3 c_center() {
@@ -362,62 +378,187 @@ namespace Canvas {
 
     std::unique_ptr<Shader> shader;
 
-    void drawObject(std::shared_ptr<GraphicObject> obj) {
-        // 1) grab its transform
-        auto const& T = obj->getTransform();
-
-        // 2) build the “base” model matrix (we’ll reuse for both passes)
-        glm::mat4 translate = glm::translate(glm::mat4(1.0f),
-            T.position);
-
-        glm::mat4 rotateZ = glm::rotate(glm::mat4(1.0f),
-            glm::radians(T.rotation.z),
-            glm::vec3{ 0,0,1 });
-        glm::mat4 rotateY = glm::rotate(glm::mat4(1.0f),
-            glm::radians(T.rotation.y),
-            glm::vec3{ 0,1,0 });
-        glm::mat4 rotateX = glm::rotate(glm::mat4(1.0f),
-            glm::radians(T.rotation.x),
-            glm::vec3{ 1,0,0 });
-        glm::mat4 rotate = rotateZ * rotateY * rotateX;
-
-        glm::mat4 baseScale = glm::scale(glm::mat4(1.0f),
-            { T.scale.x, T.scale.y, 1.0f });
-
-        // ── HALO PASS ──
-        if (obj == selectedObject) {
-            // turn off depth‐testing so the halo doesn’t write to (or get occluded by) the depth buffer
-            glDisable(GL_DEPTH_TEST);
-            // make it e.g. 10% larger:
-            float haloFactor = 1.08f;
-            glm::mat4 haloScale = glm::scale(glm::mat4(1.0f),
-                { T.scale.x * haloFactor,
-                    T.scale.y * haloFactor,
-                    1.0f });
-            glm::mat4 haloModel = translate * rotate * baseScale;
-            shader->setUniformMat4("uModel", haloModel);
-
-            // translucent yellow/orange
-            shader->setUniformVec4("uColor",
-                { 1.0f, 1.0f, 1.0f, 0.4f });
-            // draw only edges
-            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-            glLineWidth(2.0f);              // thickness of outline
-
-            obj->draw();
-
-            // restore
-            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-            glLineWidth(1.0f);
+    static FrameStats stats, lastStats;
+
+    const FrameStats& lastFrameStats() {
+        return lastStats;
+    }
+
+    // Queues one object with the backend; size and stroke travel with the instance
+    static void submitObject(RenderBackend& backend, const GraphicObject& obj, const glm::mat4& model,
+        const glm::vec4& hsva, float lineWidth) {
+        glm::vec3 size = obj.getSize();
+        InstanceData instance{ model, hsva, { size.x, size.y }, obj.getStroke() };
+        backend.submit(obj.getMesh(), obj.isFilled(), lineWidth, instance);
+    }
+
+    // ─── GL backend ───
+    // Batches through BatchRenderer into msFbo and resolves into fbo
+    class GlBackend final : public RenderBackend {
+    public:
+        void beginFrame(int width, int height, const glm::vec4& clearColor,
+            const glm::mat4& view, const glm::mat4& projection) override {
+            width_ = width;
+            height_ = height;
+
+            glBindFramebuffer(GL_FRAMEBUFFER, msFbo);
+            glViewport(0, 0, width, height);
+
             glEnable(GL_DEPTH_TEST);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glClearColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            shader->bind();
+            FrameConstants::update(view, projection);
+
+            BatchRenderer::beginFrame();
+        }
+
+        void submit(const UnitMesh& mesh, bool filled, float lineWidth, const InstanceData& instance) override {
+            BatchRenderer::submit(mesh, filled, lineWidth, instance);
         }
 
-        // ── NORMAL PASS ──
-        glm::mat4 model = translate * rotate * baseScale;
-        shader->setUniformMat4("uModel", model);
-        shader->setUniformVec4("uColor", obj->getMaterial().color);
-        obj->draw();
-	}
+        void flush(const PassState& state) override {
+            if (!state.depthTest) glDisable(GL_DEPTH_TEST);
+            if (!state.depthWrite) glDepthMask(GL_FALSE);
+            if (state.wireframe) glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+
+            BatchRenderer::flush(state.preserveOrder);
+
+            if (state.wireframe) glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+            if (!state.depthWrite) glDepthMask(GL_TRUE);
+            if (!state.depthTest) glEnable(GL_DEPTH_TEST);
+        }
+
+        void endFrame() override {
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, msFbo);
+            glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+            glBlitFramebuffer(
+                0, 0, width_, height_,
+                0, 0, width_, height_,
+                GL_COLOR_BUFFER_BIT,
+                GL_NEAREST
+            );
+        }
+
+    private:
+        int width_ = 0, height_ = 0;
+    };
+
+    static GlBackend glBackend;
+
+    // What the passes need from one object, built once per frame in the arena
+    struct DrawRecord {
+        std::uint32_t object;     // index into the scene's objects
+        std::uint32_t depthKey;   // ascending = farthest first
+        glm::mat4     model;
+        glm::vec4     hsva;
+    };
+
+    static FrameArena frameArena;
+
+    // Positive floats order the same as their bit patterns; invert for far-to-near
+    static std::uint32_t farFirstKey(float distanceSq) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &distanceSq, sizeof(bits));
+        return ~bits;
+    }
+
+    // Builds the passes for `scene` and draws them through `backend` at width×height
+    static void drawScene(RenderBackend& backend, const Scene* scene, int width, int height,
+        const glm::mat4& projection, bool showSelection) {
+        glm::vec3 center = glm::vec3(0.0f, 0.0f, 0.0f);   // Looking at origin
+        glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);       // Up direction 
+        view = glm::lookAt(cameraEye, center, up);
+
+        backend.beginFrame(width, height, { 0.12f, 0.12f, 0.12f, 1.0f }, view, projection);
+        lastStats = stats;
+        stats = FrameStats{};
+
+        // 6) Draw shapes
+        if (scene) {
+            // Records live in the arena and reference objects by index, so
+            // building the passes neither allocates nor touches refcounts
+            frameArena.reset();
+            const auto& objects = scene->objects;
+            const std::size_t n = objects.size();
+
+            // Only objects whose transform changed since last frame pay for the trig
+            stats.objects = static_cast<std::uint32_t>(n);
+            std::uint32_t* rows = frameArena.allocate<std::uint32_t>(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                rows[i] = ObjectStore::row(objects[i]->getHandle());
+                stats.transformsRecomputed += objects[i]->updateWorldMatrix() ? 1 : 0;
+            }
+            TRACE_VERBOSE("canvas: {} of {} world matrices recomputed",
+                stats.transformsRecomputed, stats.objects);
+
+            DrawRecord* opaque = frameArena.allocate<DrawRecord>(n);
+            DrawRecord* transparent = frameArena.allocate<DrawRecord>(n);
+            std::size_t opaqueCount = 0, transparentCount = 0;
+            const GraphicObject* selected = nullptr;
+
+            // Records are built from the store's columns without touching the objects
+            const ObjectStore::Columns& columns = ObjectStore::columns();
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::uint32_t row = rows[i];
+                const glm::vec4& hsva = columns.material[row].hsva;
+                glm::vec3 toEye = columns.transform[row].position - cameraEye;
+
+                DrawRecord r{ static_cast<std::uint32_t>(i), farFirstKey(glm::dot(toEye, toEye)),
+                    columns.world[row], hsva };
+                if (hsva.w >= 1.0f) {
+                    opaque[opaqueCount++] = r;
+                }
+                else {
+                    r.model[3][2] += 0.0001f;  // pull slightly toward camera, for this frame only
+                    transparent[transparentCount++] = r;
+                }
+
+                if (showSelection && objects[i] == selectedObject)
+                    selected = objects[i].get();
+            }
+
+            // ── HALO PASS ──
+            if (selected) {
+                // no depth test, so the halo doesn’t write to (or get occluded by) the depth buffer;
+                // draw only edges, in translucent white
+                PassState halo;
+                halo.depthTest = false;
+                halo.wireframe = true;
+                submitObject(backend, *selected, selected->getWorldMatrix(),
+                    { 0.0f, 0.0f, 1.0f, 0.4f }, 2.0f);
+                backend.flush(halo);
+            }
+
+            // Opaque: depth testing resolves overlap, so batch by mesh
+            for (std::size_t i = 0; i < opaqueCount; ++i) {
+                const GraphicObject& obj = *objects[opaque[i].object];
+                submitObject(backend, obj, opaque[i].model, opaque[i].hsva, obj.getLineWidth());
+            }
+            backend.flush(PassState{});
+
+            // Sort transparent back-to-front
+            DrawRecord* scratch = frameArena.allocate<DrawRecord>(transparentCount);
+            radixSort(transparent, scratch, transparentCount,
+                [](const DrawRecord& r) { return r.depthKey; });
+
+            // Draw transparent with depth mask off
+            for (std::size_t i = 0; i < transparentCount; ++i) {
+                const GraphicObject& obj = *objects[transparent[i].object];
+                submitObject(backend, obj, transparent[i].model, transparent[i].hsva, obj.getLineWidth());
+            }
+            // Keep the back-to-front order; only neighbours of the same shape share a draw
+            PassState blended;
+            blended.depthWrite = false;
+            blended.preserveOrder = true;
+            backend.flush(blended);
+        }
+
+        backend.endFrame();
+    }
 
     void Canvas::render() {
         if (Timeline::currentScene) {
@@ -500,71 +641,7 @@ namespace Canvas {
             currentH = newH;
         }
 
-        glm::vec3 center = glm::vec3(0.0f, 0.0f, 0.0f);   // Looking at origin
-        glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f);       // Up direction 
-        view = glm::lookAt(cameraEye, center, up);
-
-        glBindFramebuffer(GL_FRAMEBUFFER, msFbo);
-        glViewport(0, 0, newW, newH);
-
-        glEnable(GL_DEPTH_TEST);
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glClearColor(0.12f, 0.12f, 0.12f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        shader->bind();
-        shader->setUniformMat4("uView", view);
-        shader->setUniformMat4("uProjection", projFullScreen);
-
-        // 6) Draw shapes
-        if (currScene) {
-            std::vector<std::shared_ptr<GraphicObject>> opaque;
-            std::vector<std::shared_ptr<GraphicObject>> transparent;
-
-            for (auto& obj : currScene->objects) {
-                if (obj->getMaterial().color.a >= 1.0f)
-                    opaque.push_back(obj);
-                else
-                    transparent.push_back(obj);
-            }
-
-            // Draw opaque normally
-            for (auto& obj : opaque) {
-                drawObject(obj);  // your existing per-object logic
-            }
-
-            // Sort transparent back-to-front
-            std::sort(transparent.begin(), transparent.end(),
-                [&](const auto& a, const auto& b) {
-                    glm::vec3 pa = a->getTransform().position;
-                    glm::vec3 pb = b->getTransform().position;
-
-                    float da = glm::dot(pa - cameraEye, pa - cameraEye);
-                    float db = glm::dot(pb - cameraEye, pb - cameraEye);
-
-                    return da > db;  // sort farthest first
-                });
-
-            // Draw transparent with depth mask off
-            glDepthMask(GL_FALSE);
-            for (auto& obj : transparent) {
-                auto T = obj->getTransform();
-                T.position.z += 0.0001f;  // pull slightly toward camera
-				obj->setPosition(T.position);
-                drawObject(obj);
-            }
-            glDepthMask(GL_TRUE);
-        }
-
-        glBindFramebuffer(GL_READ_FRAMEBUFFER, msFbo);
-        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
-        glBlitFramebuffer(
-            0, 0, newW, newH,
-            0, 0, newW, newH,
-            GL_COLOR_BUFFER_BIT,
-            GL_NEAREST
-        );
+        drawScene(glBackend, currScene.get(), newW, newH, projFullScreen, true);
 
         // 7) Unbind FBO and display in ImGui
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -625,4 +702,20 @@ namespace Canvas {
         ImGui::PopStyleVar();
         ImGui::End();
     }
+
+    void renderOffscreen(const Scene* scene, int width, int height, RenderBackend* backend) {
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f),
+            float(width) / float(height), 0.1f, 100.0f);
+
+        if (backend) {
+            drawScene(*backend, scene, width, height, projection, false);
+            return;
+        }
+
+        recreate(width, height);
+        drawScene(glBackend, scene, width, height, projection, false);
+
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    }
 }
\ No newline at end of file
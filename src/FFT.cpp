@@ -0,0 +1,103 @@
+#include "FFT.h"
+#include <cmath>
+
+static constexpr double TWO_PI = 6.28318530717958647692;
+
+RealFFT::RealFFT(std::size_t size)
+{
+    // round up to a power of two (minimum 4 so the half transform has two points)
+    n_ = 4;
+    while (n_ < size) n_ <<= 1;
+    half_ = n_ / 2;
+
+    // bit-reversal permutation for the half-size complex transform
+    bitrev_.resize(half_);
+    std::size_t bits = 0;
+    while ((std::size_t(1) << bits) < half_) ++bits;
+    for (std::size_t i = 0; i < half_; ++i) {
+        std::size_t r = 0;
+        for (std::size_t b = 0; b < bits; ++b)
+            if (i & (std::size_t(1) << b)) r |= std::size_t(1) << (bits - 1 - b);
+        bitrev_[i] = r;
+    }
+
+    twRe_.resize(half_ / 2);
+    twIm_.resize(half_ / 2);
+    for (std::size_t k = 0; k < half_ / 2; ++k) {
+        double a = -TWO_PI * double(k) / double(half_);
+        twRe_[k] = float(std::cos(a));
+        twIm_[k] = float(std::sin(a));
+    }
+
+    splitRe_.resize(half_ + 1);
+    splitIm_.resize(half_ + 1);
+    for (std::size_t k = 0; k <= half_; ++k) {
+        double a = -TWO_PI * double(k) / double(n_);
+        splitRe_[k] = float(std::cos(a));
+        splitIm_[k] = float(std::sin(a));
+    }
+
+    workRe_.resize(half_);
+    workIm_.resize(half_);
+}
+
+void RealFFT::forward(const float* in, float* re, float* im)
+{
+    float* zr = workRe_.data();
+    float* zi = workIm_.data();
+
+    // 1) pack even/odd samples as one complex sequence, in bit-reversed order
+    for (std::size_t i = 0; i < half_; ++i) {
+        std::size_t j = bitrev_[i];
+        zr[j] = in[2 * i];
+        zi[j] = in[2 * i + 1];
+    }
+
+    // 2) iterative radix-2 butterflies over the half-size sequence
+    for (std::size_t len = 2; len <= half_; len <<= 1) {
+        std::size_t step = half_ / len;
+        std::size_t halfLen = len / 2;
+        for (std::size_t start = 0; start < half_; start += len) {
+            for (std::size_t k = 0; k < halfLen; ++k) {
+                float wr = twRe_[k * step];
+                float wi = twIm_[k * step];
+
+                std::size_t a = start + k;
+                std::size_t b = a + halfLen;
+
+                float tr = zr[b] * wr - zi[b] * wi;
+                float ti = zr[b] * wi + zi[b] * wr;
+
+                zr[b] = zr[a] - tr;
+                zi[b] = zi[a] - ti;
+                zr[a] += tr;
+                zi[a] += ti;
+            }
+        }
+    }
+
+    // 3) split the packed spectrum into the real signal's spectrum
+    //    X[k] = (Z[k] + Z*[M-k]) / 2  +  W^k · (-i) · (Z[k] - Z*[M-k]) / 2
+    for (std::size_t k = 0; k <= half_; ++k) {
+        std::size_t ka = (k == half_) ? 0 : k;
+        std::size_t kb = (k == 0) ? 0 : half_ - k;
+
+        float ar = zr[ka], ai = zi[ka];
+        float br = zr[kb], bi = -zi[kb];   // conjugate
+
+        float er = 0.5f * (ar + br);
+        float ei = 0.5f * (ai + bi);
+
+        float dr = 0.5f * (ar - br);
+        float di = 0.5f * (ai - bi);
+        // -i · d
+        float orr = di;
+        float oi = -dr;
+
+        float wr = splitRe_[k];
+        float wi = splitIm_[k];
+
+        re[k] = er + (orr * wr - oi * wi);
+        im[k] = ei + (orr * wi + oi * wr);
+    }
+}
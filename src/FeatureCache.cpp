@@ -0,0 +1,165 @@
+#include "FeatureCache.h"
+#include "AudioFeatureAnalyzer.h"
+#include "MappedFile.h"
+#include "SidecarJobs.h"
+#include "miniaudio.h"
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace FeatureCache {
+
+    static constexpr std::uint32_t sidecarVersion = 1;
+
+    // On-disk layout: this header, then rowCount × AudioParameter::COUNT floats
+    struct SidecarHeader {
+        char          magic[4];
+        std::uint32_t version;
+        std::uint64_t contentHash;
+        std::uint32_t sampleRate;
+        std::uint32_t hopFrames;
+        std::uint32_t fftSize;
+        std::uint32_t spectralHop;
+        std::uint32_t paramCount;
+        float         smoothingAlpha;
+        std::uint64_t rowCount;
+    };
+    static_assert(sizeof(SidecarHeader) == 48, "sidecar header must stay packed");
+
+    static SidecarHeader makeHeader(std::uint64_t hash, std::uint32_t sampleRate, float alpha) {
+        SpectralAnalyzer reference;   // picks up the live analyzer's defaults
+        SidecarHeader h{};
+        std::memcpy(h.magic, "EZF1", 4);
+        h.version = sidecarVersion;
+        h.contentHash = hash;
+        h.sampleRate = sampleRate;
+        h.hopFrames = hopFrames;
+        h.fftSize = static_cast<std::uint32_t>(reference.fftSize());
+        h.spectralHop = static_cast<std::uint32_t>(reference.hopSize());
+        h.paramCount = static_cast<std::uint32_t>(FeatureTable::stride);
+        h.smoothingAlpha = alpha;
+        return h;
+    }
+
+    static bool sameSettings(const SidecarHeader& a, const SidecarHeader& b) {
+        return std::memcmp(a.magic, b.magic, 4) == 0
+            && a.version == b.version
+            && a.contentHash == b.contentHash
+            && a.sampleRate == b.sampleRate
+            && a.hopFrames == b.hopFrames
+            && a.fftSize == b.fftSize
+            && a.spectralHop == b.spectralHop
+            && a.paramCount == b.paramCount
+            && a.smoothingAlpha == b.smoothingAlpha;
+    }
+
+    // Maps an existing sidecar if it was produced from the same bytes and settings
+    static std::shared_ptr<const FeatureTable> mapSidecar(const std::string& path,
+        const SidecarHeader& want) {
+        auto file = std::make_shared<MappedFile>();
+        if (!file->open(path) || file->size() < sizeof(SidecarHeader))
+            return nullptr;
+
+        SidecarHeader have;
+        std::memcpy(&have, file->data(), sizeof(have));
+        if (!sameSettings(have, want) || have.rowCount == 0)
+            return nullptr;
+
+        const std::size_t bytes = sizeof(SidecarHeader)
+            + static_cast<std::size_t>(have.rowCount) * FeatureTable::stride * sizeof(float);
+        if (file->size() < bytes)
+            return nullptr;
+
+        const float* rows = reinterpret_cast<const float*>(file->data() + sizeof(SidecarHeader));
+        return std::make_shared<FeatureTable>(file, rows, have.rowCount, have.hopFrames,
+            have.smoothingAlpha);
+    }
+
+    // Reads the whole file once and snapshots the analyzer after every hop
+    static bool analyze(const SidecarSource& source, std::uint32_t sampleRate, float alpha,
+        std::vector<float>& rows, std::atomic<float>& progress) {
+        SidecarReader reader(source, sampleRate, 2);
+        if (!reader.valid())
+            return false;
+
+        const std::uint32_t ch = reader.channels();
+        const std::uint64_t totalFrames = reader.lengthFrames();
+        rows.reserve(static_cast<std::size_t>(totalFrames / hopFrames + 1) * FeatureTable::stride);
+
+        AudioFeatureAnalyzer analyzer(hopFrames, alpha);
+        std::vector<float> block(static_cast<std::size_t>(hopFrames) * ch);
+
+        for (;;) {
+            if (SidecarJobs::cancelled())
+                break;
+
+            const std::uint64_t framesRead = reader.read(block.data(), hopFrames);
+            if (framesRead == 0)
+                break;
+
+            analyzer.analyze(block.data(), static_cast<std::size_t>(framesRead), ch);
+
+            rows.push_back(analyzer.getSmoothedEnvelope());
+            rows.push_back(static_cast<float>(analyzer.getZeroCrossingRate()));
+            for (std::size_t sp = 0; sp < static_cast<std::size_t>(SpectralFeature::COUNT); ++sp)
+                rows.push_back(analyzer.getSpectralFeature(static_cast<SpectralFeature>(sp)));
+
+            if (framesRead < hopFrames)
+                break;
+
+            const std::size_t hops = rows.size() / FeatureTable::stride;
+            if (totalFrames > 0 && hops % 256 == 0)
+                progress.store((std::min)(1.0f, float(double(hops) * hopFrames / double(totalFrames))),
+                    std::memory_order_relaxed);
+        }
+
+        return !SidecarJobs::cancelled() && !rows.empty();
+    }
+
+    static void runJob(const SidecarSource& source, std::uint32_t sampleRate, float alpha,
+        const std::shared_ptr<FeatureSlot>& slot) {
+        if (!source.prepare()) {
+            std::cerr << "Feature analysis could not open " << source.path() << "\n";
+            slot->failed.store(true, std::memory_order_release);
+            return;
+        }
+
+        const SidecarHeader want = makeHeader(source.contentHash(), sampleRate, alpha);
+        const std::string sidecar = source.path() + ".ezfeat";
+
+        std::shared_ptr<const FeatureTable> table = mapSidecar(sidecar, want);
+        if (!table) {
+            auto rows = std::make_shared<std::vector<float>>();
+            if (!analyze(source, sampleRate, alpha, *rows, slot->progress)) {
+                slot->failed.store(true, std::memory_order_release);
+                return;
+            }
+
+            SidecarHeader header = want;
+            header.rowCount = rows->size() / FeatureTable::stride;
+
+            if (SidecarJobs::write(sidecar, &header, sizeof(header),
+                    rows->data(), rows->size() * sizeof(float)))
+                table = mapSidecar(sidecar, want);
+
+            if (!table) {
+                // Read-only location: keep the analysis in memory for this session
+                table = std::make_shared<FeatureTable>(rows, rows->data(), header.rowCount,
+                    hopFrames, alpha);
+            }
+        }
+
+        slot->table = std::move(table);
+        slot->progress.store(1.0f, std::memory_order_relaxed);
+        slot->ready.store(true, std::memory_order_release);
+    }
+
+    std::shared_ptr<FeatureSlot> request(std::shared_ptr<const SidecarSource> source,
+        std::uint32_t sampleRate, float smoothingAlpha) {
+        auto slot = std::make_shared<FeatureSlot>();
+        SidecarJobs::submit(
+            [source, sampleRate, smoothingAlpha, slot] { runJob(*source, sampleRate, smoothingAlpha, slot); },
+            [slot] { slot->failed.store(true, std::memory_order_release); });
+        return slot;
+    }
+}
@@ -1,56 +1,87 @@
 #include "FileDialogHelper.h"
 #include "GlobalTransport.h"
+#include "ImportJobs.h"
+#include "ProjectIO.h"
 #include "Timeline.h"
-#include "TimelineTrack.h"
 #include "ImGuiFileDialog.h"
 #include "ImGuiFileDialogConfig.h"
 #include <filesystem>
-#include <random>
 #include <iostream>
-#include <ctime>
 
 namespace FileDialogHelper {
     std::string lastDirectory = ".";
+    bool openProjectDialog = false;
+    bool saveProjectDialog = false;
+    bool exportJsonDialog = false;
 
-    static std::mt19937 rng(static_cast<unsigned int>(std::time(nullptr)));
-    static std::uniform_int_distribution<int> colorDist(80, 200);
+    static void processProjectDialogs() {
+        IGFD::FileDialogConfig config{ lastDirectory };
+        if (openProjectDialog) {
+            ImGuiFileDialog::Instance()->OpenDialog("OpenProjectDlgKey", "Open Project", ProjectIO::extension, config);
+            openProjectDialog = false;
+        }
+        config.flags = ImGuiFileDialogFlags_ConfirmOverwrite;
+        if (saveProjectDialog) {
+            ImGuiFileDialog::Instance()->OpenDialog("SaveProjectDlgKey", "Save Project", ProjectIO::extension, config);
+            saveProjectDialog = false;
+        }
+        if (exportJsonDialog) {
+            ImGuiFileDialog::Instance()->OpenDialog("ExportJsonDlgKey", "Export Project as JSON", ".json", config);
+            exportJsonDialog = false;
+        }
+
+        if (ImGuiFileDialog::Instance()->Display("OpenProjectDlgKey", 0, ImVec2(500, 300), ImVec2(900, 600))) {
+            if (ImGuiFileDialog::Instance()->IsOk()) {
+                std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
+                lastDirectory = std::filesystem::path(filePath).parent_path().string();
+                // Swapping the tracks out has to wait until playback is parked
+                ProjectIO::requestLoad(filePath);
+            }
+            ImGuiFileDialog::Instance()->Close();
+        }
+
+        if (ImGuiFileDialog::Instance()->Display("SaveProjectDlgKey", 0, ImVec2(500, 300), ImVec2(900, 600))) {
+            if (ImGuiFileDialog::Instance()->IsOk()) {
+                std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
+                lastDirectory = std::filesystem::path(filePath).parent_path().string();
+                ProjectIO::save(filePath);
+            }
+            ImGuiFileDialog::Instance()->Close();
+        }
+
+        if (ImGuiFileDialog::Instance()->Display("ExportJsonDlgKey", 0, ImVec2(500, 300), ImVec2(900, 600))) {
+            if (ImGuiFileDialog::Instance()->IsOk()) {
+                std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
+                lastDirectory = std::filesystem::path(filePath).parent_path().string();
+                ProjectIO::exportJson(filePath);
+            }
+            ImGuiFileDialog::Instance()->Close();
+        }
+    }
 
     void process() {
         if (Timeline::openDialog) {
+            IGFD::FileDialogConfig config{ lastDirectory };
+            config.countSelectionMax = 0;   // any number; each one imports on its own
             ImGuiFileDialog::Instance()->OpenDialog(
                 "ChooseFileDlgKey",
-                "Choose Audio File",
+                "Choose Audio Files",
                 ".wav,.mp3,.aif",
-                IGFD::FileDialogConfig{ lastDirectory }
+                config
             );
             Timeline::openDialog = false;
         }
 
         if (ImGuiFileDialog::Instance()->Display("ChooseFileDlgKey", 0, ImVec2(500, 300), ImVec2(900, 600))) {
             if (ImGuiFileDialog::Instance()->IsOk()) {
-                std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
-                lastDirectory = std::filesystem::path(filePath).parent_path().string();
-
-                auto newTrack = std::make_unique<TimelineTrack>();
-                if (newTrack->loadTrack(filePath)) {
-                    newTrack->displayName = std::filesystem::path(filePath).filename().string();
-                    newTrack->startTime = GlobalTransport::currentTime;
-                    newTrack->color = IM_COL32(
-                        colorDist(rng),
-                        colorDist(rng),
-                        colorDist(rng),
-                        255
-                    );
-                    newTrack->computeComplementaryColor();
-
-                    Timeline::timelineTracks.push_back(std::move(newTrack));
+                for (const auto& [name, filePath] : ImGuiFileDialog::Instance()->GetSelection()) {
+                    lastDirectory = std::filesystem::path(filePath).parent_path().string();
+                    ImportJobs::request(filePath, GlobalTransport::currentTime);
                 }
-                else {
-                    std::cerr << "Failed to load audio track: " << filePath << std::endl;
-                }
-
             }
             ImGuiFileDialog::Instance()->Close();
         }
+
+        processProjectDialogs();
     }
 }
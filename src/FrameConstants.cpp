@@ -0,0 +1,27 @@
+#include "FrameConstants.h"
+
+namespace FrameConstants {
+
+    static GLuint ubo = 0;
+
+    void update(const glm::mat4& view, const glm::mat4& projection) {
+        if (ubo == 0) {
+            glGenBuffers(1, &ubo);
+            glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+            glBufferData(GL_UNIFORM_BUFFER, sizeof(Data), nullptr, GL_DYNAMIC_DRAW);
+            glBindBufferBase(GL_UNIFORM_BUFFER, binding, ubo);
+        }
+
+        Data data{ view, projection, projection * view };
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(Data), &data);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    void shutdown() {
+        if (ubo) {
+            glDeleteBuffers(1, &ubo);
+            ubo = 0;
+        }
+    }
+}
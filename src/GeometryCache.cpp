@@ -0,0 +1,207 @@
+#include "GeometryCache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+constexpr float PI = 3.14159265359f;
+
+namespace GeometryCache {
+
+    // Only the render thread builds and draws meshes, so no locking
+    static std::unordered_map<std::uint64_t, std::unique_ptr<UnitMesh>> meshes;
+
+    static std::uint64_t keyOf(ObjectType type, int segments) {
+        return (std::uint64_t(std::uint32_t(type)) << 32) | std::uint32_t(segments);
+    }
+
+    static MeshVertex vertex(glm::vec2 pos, glm::vec2 offset = glm::vec2(0.0f)) {
+        return { pos, pos + 0.5f, pos, pos, offset, 0.0f };
+    }
+
+    // Outline vertex pushed out along the miter of its two edges
+    static MeshVertex mitred(glm::vec2 pos, glm::vec2 prev, glm::vec2 next) {
+        return { pos, pos + 0.5f, prev, next, glm::vec2(0.0f), 1.0f };
+    }
+
+    // ─── Unit shapes ───
+    static void buildLine(UnitMesh& m) {
+        m.vertices = { vertex({ -0.5f, 0.0f }), vertex({ 0.5f, 0.0f }) };
+        m.indices = { 0, 1 };
+        m.primitive = GL_LINES;
+        m.fill = m.stroke = { 0, 2 };
+    }
+
+    static void buildRectangle(UnitMesh& m) {
+        const glm::vec2 corners[4] = { { -0.5f, -0.5f }, { 0.5f, -0.5f }, { 0.5f, 0.5f }, { -0.5f, 0.5f } };
+
+        // Inner quad (0-3) is inset by half the stroke on each axis; outer quad (4-7) is the full size
+        for (const auto& c : corners)
+            m.vertices.push_back(vertex(c, -c));
+        for (const auto& c : corners)
+            m.vertices.push_back(vertex(c));
+
+        m.indices = {
+            // fill: inner quad
+            0, 1, 2,  2, 3, 0,
+            // stroke: ring between the quads
+            4, 0, 1,  1, 5, 4,   // bottom
+            5, 1, 2,  2, 6, 5,   // right
+            6, 2, 3,  3, 7, 6,   // top
+            7, 3, 0,  0, 4, 7    // left
+        };
+        m.fill = { 0, 6 };
+        m.stroke = { 6, 24 };
+    }
+
+    static void buildEllipse(UnitMesh& m, int segments) {
+        const std::uint32_t n = std::uint32_t(segments);
+
+        // 0 = centre, 1..n = rim, n+1..2n = rim inset by half the stroke
+        m.vertices.push_back(vertex({ 0.0f, 0.0f }));
+        for (std::uint32_t i = 0; i < n; ++i) {
+            float theta = (float(i) / n) * 2.0f * PI;
+            glm::vec2 dir{ std::cos(theta), std::sin(theta) };
+            m.vertices.push_back(vertex(dir * 0.5f));
+        }
+        for (std::uint32_t i = 0; i < n; ++i) {
+            float theta = (float(i) / n) * 2.0f * PI;
+            glm::vec2 dir{ std::cos(theta), std::sin(theta) };
+            m.vertices.push_back(vertex(dir * 0.5f, -dir * 0.5f));
+        }
+
+        for (std::uint32_t i = 0; i < n; ++i)
+            m.indices.insert(m.indices.end(), { 0, 1 + i, 1 + (i + 1) % n });
+
+        for (std::uint32_t i = 0; i < n; ++i) {
+            std::uint32_t o0 = 1 + i, o1 = 1 + (i + 1) % n;
+            std::uint32_t i0 = 1 + n + i, i1 = 1 + n + (i + 1) % n;
+            m.indices.insert(m.indices.end(), { o0, i0, o1,  o1, i0, i1 });
+        }
+
+        m.fill = { 0, GLsizei(3 * n) };
+        m.stroke = { GLsizei(3 * n), GLsizei(6 * n) };
+    }
+
+    static void buildTriangle(UnitMesh& m) {
+        const glm::vec2 v[3] = { { 0.0f, 0.5f }, { -0.5f, -0.5f }, { 0.5f, -0.5f } };
+
+        // Inner triangle (0-2), then the same corners mitred by the stroke (3-5)
+        for (int i = 0; i < 3; ++i)
+            m.vertices.push_back(vertex(v[i]));
+        for (int i = 0; i < 3; ++i)
+            m.vertices.push_back(mitred(v[i], v[(i + 2) % 3], v[(i + 1) % 3]));
+
+        m.indices = {
+            0, 1, 2,
+            // each edge forms a quad between inner and outer triangle
+            0, 1, 4,  4, 3, 0,
+            1, 2, 5,  5, 4, 1,
+            2, 0, 3,  3, 5, 2
+        };
+        m.fill = { 0, 3 };
+        m.stroke = { 3, 18 };
+    }
+
+    static void buildStar(UnitMesh& m) {
+        const int numSpikes = 5;
+        const std::uint32_t numVerts = numSpikes * 2;
+
+        std::vector<glm::vec2> outline;
+        for (std::uint32_t i = 0; i < numVerts; ++i) {
+            float angle = (PI / numSpikes) * i - PI / 2.0f;
+            float radius = (i % 2 == 0) ? 0.5f : 0.25f;
+            outline.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+        }
+
+        // 0 = centre, 1..10 = star points, 11..20 = points mitred by the stroke
+        m.vertices.push_back(vertex({ 0.0f, 0.0f }));
+        for (const auto& p : outline)
+            m.vertices.push_back(vertex(p));
+        for (std::uint32_t i = 0; i < numVerts; ++i)
+            m.vertices.push_back(mitred(outline[i],
+                outline[(i + numVerts - 1) % numVerts], outline[(i + 1) % numVerts]));
+
+        for (std::uint32_t i = 1; i <= numVerts; ++i)
+            m.indices.insert(m.indices.end(), { 0, i, i % numVerts + 1 });
+
+        const std::uint32_t outer = 1 + numVerts;
+        for (std::uint32_t i = 0; i < numVerts; ++i) {
+            std::uint32_t i0 = 1 + i, i1 = 1 + (i + 1) % numVerts;
+            std::uint32_t o0 = outer + i, o1 = outer + (i + 1) % numVerts;
+            m.indices.insert(m.indices.end(), { i0, i1, o1,  o1, o0, i0 });
+        }
+
+        m.fill = { 0, GLsizei(3 * numVerts) };
+        m.stroke = { GLsizei(3 * numVerts), GLsizei(6 * numVerts) };
+    }
+
+    static void upload(const UnitMesh& m) {
+        glGenVertexArrays(1, &m.VAO);
+        glGenBuffers(1, &m.VBO);
+        glGenBuffers(1, &m.EBO);
+
+        glBindVertexArray(m.VAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, m.VBO);
+        glBufferData(GL_ARRAY_BUFFER, m.vertices.size() * sizeof(MeshVertex), m.vertices.data(), GL_STATIC_DRAW);
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m.EBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m.indices.size() * sizeof(std::uint32_t), m.indices.data(), GL_STATIC_DRAW);
+
+        const GLsizei stride = sizeof(MeshVertex);
+        auto attrib = [stride](GLuint index, GLint size, std::size_t offset) {
+            glEnableVertexAttribArray(index);
+            glVertexAttribPointer(index, size, GL_FLOAT, GL_FALSE, stride, (void*)offset);
+        };
+        attrib(0, 2, offsetof(MeshVertex, pos));
+        attrib(1, 2, offsetof(MeshVertex, uv));
+        attrib(2, 2, offsetof(MeshVertex, prev));
+        attrib(3, 2, offsetof(MeshVertex, next));
+        attrib(4, 2, offsetof(MeshVertex, offset));
+        attrib(5, 1, offsetof(MeshVertex, miter));
+
+        glBindVertexArray(0);
+    }
+
+    const UnitMesh& get(ObjectType type, int segments) {
+        segments = type == ObjectType::Ellipse ? (std::max)(segments, 3) : 0;
+
+        auto& slot = meshes[keyOf(type, segments)];
+        if (slot)
+            return *slot;
+
+        slot = std::make_unique<UnitMesh>();
+        switch (type) {
+        case ObjectType::Line:      buildLine(*slot); break;
+        case ObjectType::Rectangle: buildRectangle(*slot); break;
+        case ObjectType::Ellipse:   buildEllipse(*slot, segments); break;
+        case ObjectType::Triangle:  buildTriangle(*slot); break;
+        case ObjectType::Star:      buildStar(*slot); break;
+        default: break;
+        }
+        return *slot;
+    }
+
+    GLuint vertexArray(const UnitMesh& mesh) {
+        if (mesh.VAO == 0)
+            upload(mesh);
+        return mesh.VAO;
+    }
+
+    std::size_t meshCount() {
+        return meshes.size();
+    }
+
+    void shutdown() {
+        for (auto& [key, mesh] : meshes) {
+            if (mesh->VAO == 0)
+                continue;
+            glDeleteVertexArrays(1, &mesh->VAO);
+            glDeleteBuffers(1, &mesh->VBO);
+            glDeleteBuffers(1, &mesh->EBO);
+        }
+        meshes.clear();
+    }
+}
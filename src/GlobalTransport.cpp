@@ -1,8 +1,11 @@
 #include "GlobalTransport.h"
+#include "AudioClock.h"
 #include "Timeline.h"
 #include "Scene.h"
 #include "imgui.h"
 #include "Menu.h"
+#include "ScenePreloader.h"
+#include "Trace.h"
 #include <iostream>
 
 namespace GlobalTransport {
@@ -12,7 +15,6 @@ namespace GlobalTransport {
     bool isLooping = false;
     float currentTime = 0.0f;
     float totalTime = 300.0f;
-    float playStartTime = 0.0f;
     float loopStart = 0.0f;
     float loopEnd = 0.0f;
     static std::shared_ptr<Scene> loopScene = nullptr;
@@ -28,6 +30,27 @@ namespace GlobalTransport {
         loopScene = nullptr;
     }
 
+    // A jump lands inside a scene the preloader never saw coming
+    static void warmSceneAt(float seconds) {
+        if (auto scene = Timeline::sceneAt(seconds))
+            ScenePreloader::warm(*scene);
+    }
+
+    void play() {
+        warmSceneAt(currentTime);
+        AudioClock::anchor(currentTime);
+    }
+
+    void seek(float seconds) {
+        currentTime = seconds;
+        warmSceneAt(seconds);
+        AudioClock::anchor(seconds);
+        for (auto& track : Timeline::timelineTracks) {
+            if (track->playing)
+                track->playTrack(seconds);
+        }
+    }
+
     float render() {
         ImGuiIO& io = ImGui::GetIO();
         ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
@@ -40,14 +63,13 @@ namespace GlobalTransport {
         float contentWidth = 500.0f;
         ImGui::SetCursorPosX(centerX - contentWidth * 0.5f);
 
-        if (ImGui::Button("|<<")) currentTime = 0.0f;
+        if (ImGui::Button("|<<")) seek(0.0f);
         ImGui::SameLine();
         
         if (isLooping && loopScene) {
             if (currentTime >= loopEnd) {
                 Timeline::currentScene = loopScene;
-                currentTime = loopStart;
-                playStartTime = glfwGetTime() - currentTime;
+                seek(loopStart);
                 for (auto& obj : loopScene->objects)
                     obj->resetAnimations();
             }
@@ -56,11 +78,11 @@ namespace GlobalTransport {
         if (ImGui::Button(isPlaying ? "||" : ">")) {
             isPlaying = !isPlaying;
             if (isPlaying) {
-                std::cout << "Is Playing\n";
+                TRACE_INFO("Is Playing");
                 if (Timeline::currentScene) {
                     currentTime = Timeline::currentScene->startTime / 1000.0f;
                 }
-                playStartTime = glfwGetTime() - currentTime;
+                play();
                 for (auto& scene : Timeline::scenes)
                     scene->resetObjectAnimations();
             }
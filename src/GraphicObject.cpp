@@ -1,7 +1,11 @@
 #include "GraphicObject.h"
+#include <glm/gtc/matrix_transform.hpp>
 
-GraphicObject::GraphicObject(ObjectType type, const std::string& id) : type_(type), id_(id) {}
-GraphicObject::GraphicObject(const std::shared_ptr<GraphicObject>& other, int count) {
+GraphicObject::GraphicObject(ObjectType type, const std::string& id)
+    : handle_(ObjectStore::create(type)), id_(id), type_(type) {}
+
+GraphicObject::GraphicObject(const std::shared_ptr<GraphicObject>& other, int count)
+    : handle_(ObjectStore::create(other->getObjectType())) {
     // copy Animations
     for (size_t av = 0; av < static_cast<size_t>(GraphicParameter::COUNT); av++) {
         for (auto& a : other->getAnimations(av)) {
@@ -11,16 +15,15 @@ GraphicObject::GraphicObject(const std::shared_ptr<GraphicObject>& other, int co
         }
     }
 
-    // copy Type, Transforms, indices, etc.
+    // copy Type, Transforms, indices, etc.; which lanes are mapped is not
+    // carried over, and neither is anything a mapping wrote this frame
     type_ = other->getObjectType();
-    transform_ = other->getTransform();
-    material_ = other->getMaterial();
-    filled_ = other->isFilled();
-    stroke_ = other->getStroke();
-    loopType_ = other->getLoopType();
-    animationIndices_ = other->getAnimationIndices();
-    noMoreAnimations_ = other->getNoMoreAnimations();
-    mapBools_ = other->getMapBools();
+    texturePath_ = other->getTexture();
+    ObjectStore::copyComponents(other->getHandle(), handle_);
+    AnimationState& state = animationState();
+    state.isMapY = { 0 };
+    state.newMapBools = 0;
+    state.isNewMapY = { 0 };
 
     // assign ID
     std::string copyId = other->getType();
@@ -29,6 +32,10 @@ GraphicObject::GraphicObject(const std::shared_ptr<GraphicObject>& other, int co
     id_ = copyId;
 }
 
+GraphicObject::~GraphicObject() {
+    ObjectStore::destroy(handle_);
+}
+
 const char* GraphicObject::getType() const {
     auto idx = static_cast<std::size_t>(type_);
     return objectTypeNames[idx];
@@ -42,44 +49,86 @@ void GraphicObject::setId(const char* newId) {
     id_ = newId;  // implicit conversion to std::string
 }
 
-const Transform& GraphicObject::getTransform() const {
-    return transform_;
-}
-
 void GraphicObject::setPosition(const glm::vec3& p) { 
-    transform_.position = p; 
+    if (transform().position != p) {
+        transform().position = p;
+        markTransformDirty();
+    }
 }
 
 void GraphicObject::setZPosition(float z) {
-    transform_.position.z = z;
+    if (transform().position.z != z) {
+        transform().position.z = z;
+        markTransformDirty();
+    }
 };
 
 float GraphicObject::getZPosition() const {
-    return transform_.position.z;
+    return transform().position.z;
 }
 
 void GraphicObject::setRotation(const glm::vec3& rot) {
-    transform_.rotation = rot;
+    if (transform().rotation != rot) {
+        transform().rotation = rot;
+        markTransformDirty();
+    }
 }
 
 void GraphicObject::setScale(const glm::vec3& scl) {
-    transform_.scale = scl;
+    if (transform().scale != scl) {
+        transform().scale = scl;
+        markTransformDirty();
+    }
 }
 
-const Material& GraphicObject::getMaterial() const {
-    return material_;
+bool GraphicObject::updateWorldMatrix() {
+    ObjectStore::Columns& c = ObjectStore::columns();
+    const std::uint32_t r = row();
+    if (!c.transformDirty[r])
+        return false;
+
+    const Transform& T = c.transform[r];
+    glm::mat4 translate = glm::translate(glm::mat4(1.0f), T.position);
+
+    glm::mat4 rotateZ = glm::rotate(glm::mat4(1.0f), glm::radians(T.rotation.z), glm::vec3{ 0,0,1 });
+    glm::mat4 rotateY = glm::rotate(glm::mat4(1.0f), glm::radians(T.rotation.y), glm::vec3{ 0,1,0 });
+    glm::mat4 rotateX = glm::rotate(glm::mat4(1.0f), glm::radians(T.rotation.x), glm::vec3{ 1,0,0 });
+    glm::mat4 rotate = rotateZ * rotateY * rotateX;
+
+    glm::mat4 scale = glm::scale(glm::mat4(1.0f), { T.scale.x, T.scale.y, 1.0f });
+
+    c.world[r] = translate * rotate * scale;
+    c.transformDirty[r] = 0;
+    return true;
 }
 
-void GraphicObject::setColor(const glm::vec4& col) {
-    material_.color = col;
+void GraphicObject::setHSVA(const glm::vec4& hsva) {
+    material().hsva = hsva;
 }
 
 void GraphicObject::setTexture(const std::string& path) {
-    material_.texturePath = path;
+    texturePath_ = path;
 }
 
 void GraphicObject::setOpacity(float op) {
-    material_.opacity = op;
+    material().opacity = op;
+}
+
+glm::vec3 GraphicObject::getSize() const {
+    const glm::vec2& size = shape().size;
+    return { size.x, size.y, 0.0f };
+}
+
+void GraphicObject::setSize(const glm::vec3& size) {
+    shape().size = { size.x, size.y };
+}
+
+void GraphicObject::setStroke(float stroke) {
+    shape().stroke = stroke;
+}
+
+void GraphicObject::setFilled(bool filled) {
+    shape().filled = filled;
 }
 
 int GraphicObject::animations_size(int i) {
@@ -111,9 +160,9 @@ std::vector<std::shared_ptr<Animation>>& GraphicObject::getAnimations(std::size_
 
 void GraphicObject::resetAnimations(bool restart) {
     if (restart)
-        noMoreAnimations_ = 0;
+        animationState().noMoreAnimations = 0;
 
-    for(auto& animationIndex : animationIndices_)
+    for(auto& animationIndex : animationState().indices)
         animationIndex = 0;
 
     for (std::size_t i = 0; i < animations_.size(); ++i) {
@@ -124,7 +173,7 @@ void GraphicObject::resetAnimations(bool restart) {
 }
 
 void GraphicObject::setMapped(int paramIndex, bool isY) {
-    mapBools_ |= (1u << paramIndex);
+    animationState().mapBools |= (1u << paramIndex);
     if (paramIndex == 0 || (paramIndex > 2 && paramIndex < 6)) {
         std::size_t mapIndex = 0;
 
@@ -136,22 +185,22 @@ void GraphicObject::setMapped(int paramIndex, bool isY) {
         }
 
         if (isY) {
-            if (isMapY_[mapIndex] == 1)
-                isMapY_[mapIndex] = 3;
+            if (animationState().isMapY[mapIndex] == 1)
+                animationState().isMapY[mapIndex] = 3;
             else
-                isMapY_[mapIndex] = 2;
+                animationState().isMapY[mapIndex] = 2;
         }
         else {
-            if (isMapY_[mapIndex] == 2)
-                isMapY_[mapIndex] = 3;
+            if (animationState().isMapY[mapIndex] == 2)
+                animationState().isMapY[mapIndex] = 3;
             else
-				isMapY_[mapIndex] = 1;
+				animationState().isMapY[mapIndex] = 1;
         }
     }
 }
 
 void GraphicObject::setUnmapped(int paramIndex, bool isY) {
-    mapBools_ &= ~(1u << paramIndex);
+    animationState().mapBools &= ~(1u << paramIndex);
     if (paramIndex == 0 || (paramIndex > 2 && paramIndex < 6)) {
         std::size_t mapIndex = 0;
 
@@ -163,59 +212,56 @@ void GraphicObject::setUnmapped(int paramIndex, bool isY) {
         }
 
         if (isY)
-            if(isMapY_[mapIndex] == 3)
-                isMapY_[mapIndex] = 1;
+            if(animationState().isMapY[mapIndex] == 3)
+                animationState().isMapY[mapIndex] = 1;
             else
-                isMapY_[mapIndex] = 0;
+                animationState().isMapY[mapIndex] = 0;
         else {
-            if (isMapY_[mapIndex] == 3)
-                isMapY_[mapIndex] = 2;
+            if (animationState().isMapY[mapIndex] == 3)
+                animationState().isMapY[mapIndex] = 2;
             else
-				isMapY_[mapIndex] = 0;
+				animationState().isMapY[mapIndex] = 0;
         }
     }
 }
 
 bool GraphicObject::isMapped(int paramIndex) {
-    return (mapBools_ & (1u << paramIndex)) != 0;
+    return (animationState().mapBools & (1u << paramIndex)) != 0;
 }
 
 int GraphicObject::isMappedY(int paramIndex) const {
-	return isMapY_[paramIndex];
+	return animationState().isMapY[paramIndex];
 }
 
 glm::vec2 GraphicObject::getParameterValue(int p_i) const {
 	GraphicParameter param = static_cast<GraphicParameter>(p_i);
     switch (param) {
     case GraphicParameter::Position: {
-        return { transform_.position.x, transform_.position.y };
+        return { transform().position.x, transform().position.y };
     }
     case GraphicParameter::ZPosition: {
-        return { transform_.position.z, 0.0f };
+        return { transform().position.z, 0.0f };
     }
     case GraphicParameter::Rotation: {
-        return { transform_.rotation.z, 0.0f };
+        return { transform().rotation.z, 0.0f };
     }
     case GraphicParameter::XY_Rotation: {
-        return { transform_.rotation.x, transform_.rotation.y };
+        return { transform().rotation.x, transform().rotation.y };
     }
     case GraphicParameter::Size:{
         return { getSize().x, getSize().y};
     }
     case GraphicParameter::Hue_Sat: {
-        glm::vec4 color = ScenesPanel::rgb2hsv(material_.color);
-        return { color.x, color.y };
+        return { material().hsva.x, material().hsva.y };
     }
     case GraphicParameter::Brightness: {
-        glm::vec4 color = ScenesPanel::rgb2hsv(material_.color);
-        return { color.z, 0.0f };
+        return { material().hsva.z, 0.0f };
     }
     case GraphicParameter::Alpha: {
-        glm::vec4 color = ScenesPanel::rgb2hsv(material_.color);
-        return { color.w, 0.0f };
+        return { material().hsva.w, 0.0f };
     }
     case GraphicParameter::Stroke: { // Stroke
-        return { stroke_, 0.0f };
+        return { getStroke(), 0.0f };
     }
     default:
         return { 0.0f, 0.0f };
@@ -226,7 +272,7 @@ void GraphicObject::setParameter(int p_i, glm::vec2 value) {
 	GraphicParameter param = static_cast<GraphicParameter>(p_i);
     switch (param) {
     case GraphicParameter::Position: {
-        setPosition({ value, transform_.position.z });
+        setPosition({ value, transform().position.z });
         break;
     }
     case GraphicParameter::ZPosition: {
@@ -234,11 +280,11 @@ void GraphicObject::setParameter(int p_i, glm::vec2 value) {
 		break;
     }
     case GraphicParameter::Rotation: {
-        setRotation({ transform_.rotation.x, transform_.rotation.y, value.x });
+        setRotation({ transform().rotation.x, transform().rotation.y, value.x });
         break;
     }
     case GraphicParameter::XY_Rotation: {
-		setRotation({ value.x, value.y, transform_.rotation.z });
+		setRotation({ value.x, value.y, transform().rotation.z });
         break;
     }
     case GraphicParameter::Size: {
@@ -246,18 +292,16 @@ void GraphicObject::setParameter(int p_i, glm::vec2 value) {
         break;
     }
     case GraphicParameter::Hue_Sat: {
-        glm::vec4 color = ScenesPanel::rgb2hsv(material_.color);
-        setColor(ScenesPanel::hsv2rgb({ value, color.z, color.w }));
+        material().hsva.x = value.x;
+        material().hsva.y = value.y;
         break;
     }
     case GraphicParameter::Brightness: {
-        glm::vec4 color = ScenesPanel::rgb2hsv(material_.color);
-        setColor(ScenesPanel::hsv2rgb({ color.x, color.y, value.x, color.w }));
+        material().hsva.z = value.x;
         break;
     }
     case GraphicParameter::Alpha: {
-        glm::vec4 color = ScenesPanel::rgb2hsv(material_.color);
-        setColor(ScenesPanel::hsv2rgb({ color.x, color.y, color.z, value.x }));
+        material().hsva.w = value.x;
         break;
     }
     case GraphicParameter::Stroke: {
@@ -281,7 +325,7 @@ void GraphicObject::setNewMapBools(int paramIndex, bool isY) {
     }
 
     if (mapIndex > -1) {
-        unsigned int& currentState = isNewMapY_[mapIndex];
+        unsigned int& currentState = animationState().isNewMapY[mapIndex];
         if (isY) {
             if (currentState == 0)
                 currentState = 2; // Y-mapped
@@ -295,27 +339,29 @@ void GraphicObject::setNewMapBools(int paramIndex, bool isY) {
                 currentState = 3; // Y-mapped and X-mapped
         }
     }
-    newMapBools_ |= (1u << paramIndex);
+    animationState().newMapBools |= (1u << paramIndex);
 }
 
 void GraphicObject::updateYMappedParameter(int xyIndex, glm::vec2 value, bool isY) {
     switch (xyIndex) {
     case 0: { // Position
         if (!isY) {
-            transform_.position.y = value.y;
+            transform().position.y = value.y;
         }
         else {
-            transform_.position.x = value.x;
+            transform().position.x = value.x;
         }
+        markTransformDirty();
         break;
     }
     case 1: { // XY-Rotation
         if (!isY) {
-            transform_.rotation.y = value.y;
+            transform().rotation.y = value.y;
         }
         else {
-            transform_.rotation.x = value.x;
+            transform().rotation.x = value.x;
         }
+        markTransformDirty();
         break;
     }
     case 2: { // Size
@@ -329,12 +375,10 @@ void GraphicObject::updateYMappedParameter(int xyIndex, glm::vec2 value, bool is
     }
     case 3: { // Hue/Saturation
         if (!isY) {
-            glm::vec4 color = ScenesPanel::rgb2hsv(material_.color);
-            setColor(ScenesPanel::hsv2rgb({ color.x, value.y, color.z, color.w }));
+            material().hsva.y = value.y;
         }
         else {
-            glm::vec4 color = ScenesPanel::rgb2hsv(material_.color);
-            setColor(ScenesPanel::hsv2rgb({ value.x, color.y, color.z, color.w }));
+            material().hsva.x = value.x;
         }
         break;
     }
@@ -344,9 +388,10 @@ void GraphicObject::updateYMappedParameter(int xyIndex, glm::vec2 value, bool is
 };
 
 void GraphicObject::update() {
+    AnimationState& state = animationState();
     for (int parameter = 0; parameter < animations_.size(); ++parameter) {
-        std::size_t currentAnimation = animationIndices_[parameter];
-        if ((newMapBools_ & (1u << parameter)) != 0) {
+        std::size_t currentAnimation = state.indices[parameter];
+        if ((state.newMapBools & (1u << parameter)) != 0) {
             int mapIndex = -1;
             switch (parameter) {
             case 0: { mapIndex = 0; break; }
@@ -358,17 +403,17 @@ void GraphicObject::update() {
 
             if (mapIndex > -1) {
                 if (animations_[parameter].size() > 0) {
-                    bool isY = (isNewMapY_[mapIndex] >= 2);
-                    if (!animations_[parameter][currentAnimation]->is_finished() && isNewMapY_[mapIndex] < 3) {
+                    bool isY = (state.isNewMapY[mapIndex] >= 2);
+                    if (!animations_[parameter][currentAnimation]->is_finished() && state.isNewMapY[mapIndex] < 3) {
                         glm::vec2 updateValue = animations_[parameter][currentAnimation]->getValue(GlobalTransport::currentTime * 1000.0f);
                         updateYMappedParameter(mapIndex, updateValue, isY);
                     }
                 }
 			}
         }
-        else if (animations_[parameter].size() > 0 && (noMoreAnimations_ & (1u << parameter)) == 0) {
+        else if (animations_[parameter].size() > 0 && (state.noMoreAnimations & (1u << parameter)) == 0) {
             bool animationIsFinished = animations_[parameter][currentAnimation]->is_finished();
-            std::cout << "animationIsFinished = " << std::boolalpha << animationIsFinished << '\n';
+            TRACE_VERBOSE("animationIsFinished = {}", animationIsFinished);
             if (!animationIsFinished) {
                 glm::vec2 updateValue = animations_[parameter][currentAnimation]->getValue(GlobalTransport::currentTime * 1000.0f);
 
@@ -380,29 +425,29 @@ void GraphicObject::update() {
         }
     }
 
-    newMapBools_ = 0;
-    isNewMapY_ = { 0 };
+    state.newMapBools = 0;
+    state.isNewMapY = { 0 };
 }
 
 
 void GraphicObject::setLoopType(LoopType loop) {
-    loopType_ = loop;
+    animationState().loopType = loop;
 }
 
 const LoopType const GraphicObject::getLoopType() {
-    return loopType_;
+    return animationState().loopType;
 }
 
 void GraphicObject::updateAnimationIndex(int parameter) {
-    auto& currentAnimationIndex = animationIndices_[parameter];
-    std::cout << "currentAnimationIndex = " << currentAnimationIndex;
+    auto& currentAnimationIndex = animationState().indices[parameter];
+    TRACE_DEBUG("currentAnimationIndex = {}", currentAnimationIndex);
 
-    switch (loopType_) {
+    switch (animationState().loopType) {
     case LoopType::Off: {
         animations_[parameter][currentAnimationIndex]->resetAnimation();
-        std::cout << "Updated currentAnimationIndex to " << currentAnimationIndex << '\n';
+        TRACE_DEBUG("Updated currentAnimationIndex to {}", currentAnimationIndex);
         if (currentAnimationIndex + 1 >= animations_size(parameter)) {
-            noMoreAnimations_ |= (1u << parameter);
+            animationState().noMoreAnimations |= (1u << parameter);
         }
         else {
             currentAnimationIndex++;
@@ -418,7 +463,7 @@ void GraphicObject::updateAnimationIndex(int parameter) {
         else {
             currentAnimationIndex++;
         }
-        std::cout << "Updated currentAnimationIndex to " << currentAnimationIndex << '\n';
+        TRACE_DEBUG("Updated currentAnimationIndex to {}", currentAnimationIndex);
         animations_[parameter][currentAnimationIndex]->resetAnimation();
         break;
     }
@@ -427,7 +472,7 @@ void GraphicObject::updateAnimationIndex(int parameter) {
         std::uniform_int_distribution<int> dist(0, animations_size(parameter) - 1);
         int random_index = dist(get_rng());
         currentAnimationIndex = (std::size_t)(random_index);
-        std::cout << "Updated currentAnimationIndex to " << currentAnimationIndex << '\n';
+        TRACE_DEBUG("Updated currentAnimationIndex to {}", currentAnimationIndex);
         animations_[parameter][currentAnimationIndex]->resetAnimation();
         break;
     }
@@ -435,13 +480,13 @@ void GraphicObject::updateAnimationIndex(int parameter) {
 }
 
 const std::array<std::size_t, static_cast<std::size_t>(GraphicParameter::COUNT)>& GraphicObject::getAnimationIndices() {
-    return animationIndices_;
+    return animationState().indices;
 }
 
 const unsigned int GraphicObject::getNoMoreAnimations() {
-    return noMoreAnimations_;
+    return animationState().noMoreAnimations;
 }
 
 const unsigned int GraphicObject::getMapBools() {
-    return mapBools_;
+    return animationState().mapBools;
 }
\ No newline at end of file
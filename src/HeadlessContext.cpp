@@ -0,0 +1,138 @@
+#include "HeadlessContext.h"
+#include <glad/glad.h>
+#include <iostream>
+
+#ifdef EZVZ_WITH_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#else
+#include <GLFW/glfw3.h>
+#endif
+
+namespace HeadlessContext {
+
+#ifdef EZVZ_WITH_EGL
+
+    static EGLDisplay display = EGL_NO_DISPLAY;
+    static EGLSurface surface = EGL_NO_SURFACE;
+    static EGLContext context = EGL_NO_CONTEXT;
+
+    static EGLDisplay openDisplay() {
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+        // No window system at all; llvmpipe renders straight into our FBOs
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) {
+            EGLDisplay d = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (d != EGL_NO_DISPLAY && eglInitialize(d, nullptr, nullptr))
+                return d;
+        }
+#endif
+        EGLDisplay d = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (d != EGL_NO_DISPLAY && eglInitialize(d, nullptr, nullptr))
+            return d;
+        return EGL_NO_DISPLAY;
+    }
+
+    bool create() {
+        display = openDisplay();
+        if (display == EGL_NO_DISPLAY) {
+            std::cerr << "Failed to initialize an EGL display\n";
+            return false;
+        }
+
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+            EGL_NONE
+        };
+        EGLConfig config;
+        EGLint configCount = 0;
+        if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0) {
+            std::cerr << "No EGL config supports desktop OpenGL\n";
+            destroy();
+            return false;
+        }
+
+        // Surfaceless displays may refuse a pbuffer; a context without a surface is enough
+        const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+
+        eglBindAPI(EGL_OPENGL_API);
+        const EGLint contextAttribs[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+        if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, surface, surface, context)) {
+            std::cerr << "Failed to create an OpenGL 3.3 core context through EGL\n";
+            destroy();
+            return false;
+        }
+
+        if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress))) {
+            std::cerr << "Failed to initialize GLAD\n";
+            destroy();
+            return false;
+        }
+        return true;
+    }
+
+    void destroy() {
+        if (display == EGL_NO_DISPLAY)
+            return;
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context != EGL_NO_CONTEXT)
+            eglDestroyContext(display, context);
+        if (surface != EGL_NO_SURFACE)
+            eglDestroySurface(display, surface);
+        eglTerminate(display);
+        display = EGL_NO_DISPLAY;
+        surface = EGL_NO_SURFACE;
+        context = EGL_NO_CONTEXT;
+    }
+
+#else
+
+    static GLFWwindow* window = nullptr;
+
+    bool create() {
+        if (!glfwInit()) {
+            std::cerr << "Failed to initialize GLFW\n";
+            return false;
+        }
+
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+        window = glfwCreateWindow(16, 16, "ezvz render", nullptr, nullptr);
+        if (!window) {
+            std::cerr << "Failed to create a hidden GLFW window\n";
+            glfwTerminate();
+            return false;
+        }
+        glfwMakeContextCurrent(window);
+
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+            std::cerr << "Failed to initialize GLAD\n";
+            destroy();
+            return false;
+        }
+        return true;
+    }
+
+    void destroy() {
+        if (!window)
+            return;
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        window = nullptr;
+    }
+
+#endif
+}
@@ -0,0 +1,140 @@
+#include "ImportJobs.h"
+#include "ThreadPool.h"
+#include "Timeline.h"
+#include "TimelineIndex.h"
+#include "TimelineTrack.h"
+#include "Trace.h"
+#include "TrackSet.h"
+#include <ctime>
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+#include <random>
+
+namespace ImportJobs {
+
+    static std::unique_ptr<ThreadPool> pool;
+    static std::mutex poolMutex;
+    static std::atomic<bool> cancelled{ false };
+    static std::vector<std::shared_ptr<Import>> imports;   // main thread only
+
+    static std::mt19937 rng(static_cast<unsigned int>(std::time(nullptr)));
+    static std::uniform_int_distribution<int> colorDist(80, 200);
+
+    static bool settled(const FeatureSlot* features) {
+        return !features || features->ready.load(std::memory_order_acquire)
+            || features->failed.load(std::memory_order_acquire);
+    }
+
+    static bool settled(const WaveformSlot* waveform) {
+        return !waveform || waveform->ready.load(std::memory_order_acquire)
+            || waveform->failed.load(std::memory_order_acquire);
+    }
+
+    static float slotProgress(const FeatureSlot* features) {
+        return settled(features) ? 1.0f : features->progress.load(std::memory_order_relaxed);
+    }
+
+    static float slotProgress(const WaveformSlot* waveform) {
+        return settled(waveform) ? 1.0f : waveform->progress.load(std::memory_order_relaxed);
+    }
+
+    float Import::progress() const {
+        switch (stage.load(std::memory_order_acquire)) {
+        case Stage::Queued:
+            return 0.0f;
+        case Stage::Opening:
+            return 0.05f;
+        case Stage::Analysing:
+            return 0.1f + 0.45f * (slotProgress(track->features.get()) + slotProgress(track->waveform.get()));
+        default:
+            return 0.0f;
+        }
+    }
+
+    static void runJob(const std::shared_ptr<Import>& import) {
+        import->stage.store(Stage::Opening, std::memory_order_release);
+
+        auto track = std::make_unique<TimelineTrack>();
+        if (!track->loadTrack(import->path)) {
+            import->stage.store(Stage::Failed, std::memory_order_release);
+            return;
+        }
+        import->track = std::move(track);
+        import->stage.store(Stage::Analysing, std::memory_order_release);
+    }
+
+    void request(const std::string& path, float startTime) {
+        auto import = std::make_shared<Import>();
+        import->path = path;
+        import->displayName = std::filesystem::path(path).filename().string();
+        import->startTime = startTime;
+        imports.push_back(import);
+
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!pool) {
+            cancelled.store(false, std::memory_order_relaxed);
+            pool = std::make_unique<ThreadPool>();
+        }
+        pool->submit([import] {
+            if (!cancelled.load(std::memory_order_relaxed))
+                runJob(import);
+        });
+    }
+
+    void publish() {
+        bool published = false;
+        for (auto it = imports.begin(); it != imports.end();) {
+            Import& import = **it;
+            const Stage stage = import.stage.load(std::memory_order_acquire);
+
+            if (stage == Stage::Failed) {
+                std::cerr << "Failed to load audio track: " << import.path << std::endl;
+                it = imports.erase(it);
+                continue;
+            }
+            if (stage != Stage::Analysing || !settled(import.track->features.get())
+                || !settled(import.track->waveform.get())) {
+                ++it;
+                continue;
+            }
+
+            auto& track = import.track;
+            track->displayName = import.displayName;
+            track->startTime = import.startTime;
+            track->color = IM_COL32(
+                colorDist(rng),
+                colorDist(rng),
+                colorDist(rng),
+                255
+            );
+            track->computeComplementaryColor();
+
+            Timeline::timelineTracks.push_back(std::move(track));
+            published = true;
+            TRACE_INFO("Track imported");
+            it = imports.erase(it);
+        }
+        if (published) {
+            TrackSet::publish();
+            TimelineIndex::tracksChanged();
+        }
+    }
+
+    const std::vector<std::shared_ptr<Import>>& active() {
+        return imports;
+    }
+
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            cancelled.store(true, std::memory_order_relaxed);
+            pool.reset();   // queued imports return immediately; running ones finish their load
+        }
+        for (auto& import : imports) {
+            if (import->track)
+                import->track->unloadTrack();
+        }
+        imports.clear();
+    }
+}
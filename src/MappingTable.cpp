@@ -0,0 +1,207 @@
+#include "MappingTable.h"
+#include <algorithm>
+#include <unordered_map>
+
+// Parameters whose x and y are mapped independently (see GraphicObject::setNewMapBools)
+static bool isLaneSplit(std::uint8_t param) {
+    switch (static_cast<GraphicParameter>(param)) {
+    case GraphicParameter::Position:
+    case GraphicParameter::XY_Rotation:
+    case GraphicParameter::Size:
+    case GraphicParameter::Hue_Sat:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void MappingTable::compile(MappingLists& mappings) {
+    // Hand the edge state back before the owners can go away
+    for (std::size_t i = 0; i < trig_.owner.size(); ++i)
+        trig_.owner[i]->setReachedThreshold(trig_.reached[i] != 0);
+
+    struct Entry {
+        std::shared_ptr<Mapping> mapping;
+        std::uint32_t target;
+        std::uint8_t source;
+        std::uint8_t param;
+        std::uint8_t lane;
+    };
+    std::vector<Entry> syncEntries, trigEntries;
+
+    targets_.clear();
+    std::unordered_map<const GraphicObject*, std::uint32_t> slotOf;
+
+    for (std::size_t ap = 0; ap < mappings.size(); ++ap) {
+        auto& list = mappings[ap];
+        list.erase(std::remove_if(list.begin(), list.end(),
+            [](const std::shared_ptr<Mapping>& m) { return !m->isMapped(); }), list.end());
+
+        for (auto& m : list) {
+            auto obj = m->getMappedObject();
+            auto it = slotOf.find(obj.get());
+            if (it == slotOf.end()) {
+                it = slotOf.emplace(obj.get(), static_cast<std::uint32_t>(targets_.size())).first;
+                targets_.push_back(obj);
+            }
+
+            Entry e{ m, it->second, static_cast<std::uint8_t>(ap),
+                static_cast<std::uint8_t>(m->getGraphicParameter()),
+                static_cast<std::uint8_t>(m->getGParamY() ? 1 : 0) };
+            (m->getMapType() == MapType::Trigger ? trigEntries : syncEntries).push_back(std::move(e));
+        }
+    }
+
+    // Group writes to the same object/parameter; stable so the last mapping still wins a lane
+    std::stable_sort(syncEntries.begin(), syncEntries.end(), [](const Entry& a, const Entry& b) {
+        if (a.target != b.target) return a.target < b.target;
+        return a.param < b.param;
+    });
+
+    // ─── Sync columns ───
+    SyncColumns s;
+    const std::size_t ns = syncEntries.size();
+    s.source.resize(ns); s.inLo.resize(ns); s.inHi.resize(ns); s.inBase.resize(ns);
+    s.outBase.resize(ns); s.scale.resize(ns); s.target.resize(ns); s.param.resize(ns);
+    s.lane.resize(ns); s.out.resize(ns); s.active.resize(ns);
+
+    for (std::size_t i = 0; i < ns; ++i) {
+        const Entry& e = syncEntries[i];
+        const auto& sm = static_cast<const SyncMapping&>(*e.mapping);
+        const glm::vec2 in = sm.getInputMapping();
+        const glm::vec2 out = sm.getOutputMapping();
+
+        s.source[i] = e.source;
+        s.inLo[i] = (std::min)(in.x, in.y);
+        s.inHi[i] = (std::max)(in.x, in.y);
+        s.inBase[i] = in.x;
+        // A zero-width input range pins the output to its far end
+        if (in.y - in.x == 0.0f) {
+            s.outBase[i] = out.y;
+            s.scale[i] = 0.0f;
+        }
+        else {
+            s.outBase[i] = out.x;
+            s.scale[i] = (out.y - out.x) / (in.y - in.x);
+        }
+        s.target[i] = e.target;
+        s.param[i] = e.param;
+        s.lane[i] = e.lane;
+    }
+    sync_ = std::move(s);
+
+    // ─── Trigger columns ───
+    TriggerColumns t;
+    const std::size_t nt = trigEntries.size();
+    t.source.resize(nt); t.sign.resize(nt); t.signedThreshold.resize(nt); t.reached.resize(nt);
+    t.target.resize(nt); t.param.resize(nt); t.animation.resize(nt); t.owner.resize(nt);
+
+    for (std::size_t i = 0; i < nt; ++i) {
+        const Entry& e = trigEntries[i];
+        auto tm = std::static_pointer_cast<TriggerMapping>(e.mapping);
+
+        // "v >= th" and "v <= th" both become  v·sign >= th·sign
+        const float sign = tm->isGreaterThan() ? 1.0f : -1.0f;
+        t.source[i] = e.source;
+        t.sign[i] = sign;
+        t.signedThreshold[i] = tm->getThreshold() * sign;
+        t.reached[i] = tm->hasReachedThreshold() ? 1 : 0;
+        t.target[i] = e.target;
+        t.param[i] = e.param;
+        t.animation[i] = static_cast<std::uint32_t>(tm->getAnimationIndex());
+        t.owner[i] = std::move(tm);
+    }
+    trig_ = std::move(t);
+
+    locked_.reserve(targets_.size());
+    compiledEpoch_ = MappingEpoch::current;
+    targetExpired_ = false;
+}
+
+void MappingTable::evaluateTriggers(const float* values) {
+    const std::size_t n = trig_.source.size();
+    std::uint8_t* reached = trig_.reached.data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const float v = values[trig_.source[i]];
+        const std::uint8_t hit = (v * trig_.sign[i] >= trig_.signedThreshold[i]) ? 1 : 0;
+        const std::uint8_t fire = hit & static_cast<std::uint8_t>(reached[i] ^ 1);
+        reached[i] = hit;
+
+        if (fire) {
+            auto obj = targets_[trig_.target[i]].lock();
+            if (!obj) {
+                targetExpired_ = true;
+                continue;
+            }
+            auto& anims = obj->getAnimations(trig_.param[i]);
+            if (trig_.animation[i] < anims.size())
+                anims[trig_.animation[i]]->trigger();
+        }
+    }
+}
+
+bool MappingTable::lockTargets() {
+    locked_.clear();
+    bool any = false;
+    for (auto& weak : targets_) {
+        locked_.push_back(weak.lock());
+        if (locked_.back())
+            any = true;
+        else
+            targetExpired_ = true;
+    }
+    return any;
+}
+
+void MappingTable::evaluateSync(const float* values) {
+    const std::size_t n = sync_.source.size();
+
+    // 1) every mapping's output, branch-free
+    const std::uint8_t* source = sync_.source.data();
+    const float* inLo = sync_.inLo.data();
+    const float* inHi = sync_.inHi.data();
+    const float* inBase = sync_.inBase.data();
+    const float* outBase = sync_.outBase.data();
+    const float* scale = sync_.scale.data();
+    float* out = sync_.out.data();
+    std::uint8_t* active = sync_.active.data();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const float v = values[source[i]];
+        active[i] = static_cast<std::uint8_t>((v >= inLo[i]) & (v <= inHi[i]));
+        out[i] = outBase[i] + (v - inBase[i]) * scale[i];
+    }
+
+    // 2) one read/write per object parameter
+    if (!lockTargets())
+        return;
+
+    for (std::size_t i = 0; i < n; ) {
+        const std::uint32_t target = sync_.target[i];
+        const std::uint8_t param = sync_.param[i];
+        std::size_t end = i;
+        bool any = false;
+        while (end < n && sync_.target[end] == target && sync_.param[end] == param)
+            any |= active[end++] != 0;
+
+        GraphicObject* obj = locked_[target].get();
+        if (obj && any) {
+            glm::vec2 value = isLaneSplit(param) ? obj->getParameterValue(param) : glm::vec2(0.0f);
+            for (std::size_t k = i; k < end; ++k) {
+                if (active[k])
+                    value[sync_.lane[k]] = out[k];
+            }
+            obj->setParameter(param, value);
+            for (std::size_t k = i; k < end; ++k) {
+                if (active[k])
+                    obj->setNewMapBools(param, sync_.lane[k] == 1);
+            }
+        }
+        i = end;
+    }
+
+    // Don't keep deleted objects alive until the next frame
+    for (auto& obj : locked_)
+        obj.reset();
+}
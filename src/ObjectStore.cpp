@@ -0,0 +1,80 @@
+#include "ObjectStore.h"
+
+ObjectHandle ObjectStore::create(ObjectType type) {
+    Storage& s = storage();
+    Columns& c = s.columns;
+
+    std::uint32_t index;
+    if (!s.freeSlots.empty()) {
+        index = s.freeSlots.back();
+        s.freeSlots.pop_back();
+    }
+    else {
+        index = static_cast<std::uint32_t>(s.slots.size());
+        s.slots.emplace_back();
+    }
+
+    Slot& slot = s.slots[index];
+    slot.row = static_cast<std::uint32_t>(c.slot.size());
+    slot.live = true;
+
+    c.type.push_back(type);
+    c.transform.emplace_back();
+    c.world.emplace_back(1.0f);
+    c.transformDirty.push_back(1);
+    c.material.emplace_back();
+    c.shape.emplace_back();
+    c.animation.emplace_back();
+    c.slot.push_back(index);
+
+    return { index, slot.generation };
+}
+
+void ObjectStore::destroy(ObjectHandle h) {
+    if (!alive(h))
+        return;
+
+    Storage& s = storage();
+    Columns& c = s.columns;
+    Slot& slot = s.slots[h.index];
+    const std::uint32_t row = slot.row;
+    const std::uint32_t last = static_cast<std::uint32_t>(c.slot.size() - 1);
+
+    // Keep the columns dense: the last row moves into the hole
+    if (row != last) {
+        c.type[row] = c.type[last];
+        c.transform[row] = c.transform[last];
+        c.world[row] = c.world[last];
+        c.transformDirty[row] = c.transformDirty[last];
+        c.material[row] = c.material[last];
+        c.shape[row] = c.shape[last];
+        c.animation[row] = c.animation[last];
+        c.slot[row] = c.slot[last];
+        s.slots[c.slot[row]].row = row;
+    }
+    c.type.pop_back();
+    c.transform.pop_back();
+    c.world.pop_back();
+    c.transformDirty.pop_back();
+    c.material.pop_back();
+    c.shape.pop_back();
+    c.animation.pop_back();
+    c.slot.pop_back();
+
+    slot.live = false;
+    ++slot.generation;
+    s.freeSlots.push_back(h.index);
+}
+
+void ObjectStore::copyComponents(ObjectHandle from, ObjectHandle to) {
+    Columns& c = columns();
+    const std::uint32_t src = row(from);
+    const std::uint32_t dst = row(to);
+
+    c.transform[dst] = c.transform[src];
+    c.world[dst] = c.world[src];
+    c.transformDirty[dst] = c.transformDirty[src];
+    c.material[dst] = c.material[src];
+    c.shape[dst] = c.shape[src];
+    c.animation[dst] = c.animation[src];
+}
@@ -0,0 +1,420 @@
+#include "OfflineRenderer.h"
+#include "AnimationSystem.h"
+#include "AudioEngine.h"
+#include "Canvas.h"
+#include "GlobalTransport.h"
+#include "Scene.h"
+#include "SoftwareRasterizer.h"
+#include "ThreadPool.h"
+#include "Timeline.h"
+#include "TimelineIndex.h"
+#include "TimelineTrack.h"
+#include "TrackStreamer.h"
+#include "Trace.h"
+#include <glad/glad.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace OfflineRenderer {
+
+    // How long the mixer waits on the streamer before mixing whatever is buffered
+    static constexpr std::chrono::seconds decodeStallTimeout{ 2 };
+
+    static std::optional<Settings> pending;
+
+    void request(const Settings& settings) {
+        pending = settings;
+    }
+
+    bool takeRequest(Settings& settings) {
+        if (!pending)
+            return false;
+        settings = *pending;
+        pending.reset();
+        return true;
+    }
+
+    // ─── Output files ───
+    static FILE* openOutput(const std::string& path) {
+        if (path == "-") {
+#ifdef _WIN32
+            _setmode(_fileno(stdout), _O_BINARY);
+#endif
+            return stdout;
+        }
+        return std::fopen(path.c_str(), "wb");
+    }
+
+    static bool closeOutput(FILE* f) {
+        if (!f)
+            return true;
+        bool ok = std::ferror(f) == 0;
+        if (f == stdout)
+            return std::fflush(f) == 0 && ok;
+        return std::fclose(f) == 0 && ok;
+    }
+
+    template <typename T>
+    static void put(FILE* f, T value) {
+        std::fwrite(&value, sizeof(T), 1, f);   // RIFF is little-endian, as are all our targets
+    }
+
+    // Sizes are known before the first sample, so the file never needs
+    // patching afterwards and can just as well be a pipe
+    static void writeWavHeader(FILE* f, std::uint64_t frames) {
+        const std::uint16_t channels = AudioEngine::outputChannels;
+        const std::uint32_t bytesPerFrame = channels * sizeof(float);
+        const std::uint32_t dataBytes = std::uint32_t((std::min)(
+            frames * bytesPerFrame, std::uint64_t(UINT32_MAX - 36)));
+
+        std::fwrite("RIFF", 1, 4, f);
+        put<std::uint32_t>(f, 36 + dataBytes);
+        std::fwrite("WAVEfmt ", 1, 8, f);
+        put<std::uint32_t>(f, 16);
+        put<std::uint16_t>(f, 3);                  // IEEE float
+        put<std::uint16_t>(f, channels);
+        put<std::uint32_t>(f, AudioEngine::sampleRate);
+        put<std::uint32_t>(f, AudioEngine::sampleRate * bytesPerFrame);
+        put<std::uint16_t>(f, std::uint16_t(bytesPerFrame));
+        put<std::uint16_t>(f, 32);
+        std::fwrite("data", 1, 4, f);
+        put<std::uint32_t>(f, dataBytes);
+    }
+
+    // ─── Colour conversion ───
+    // BT.601 full range (C420jpeg), 16-bit fixed point. GL rows run bottom-up,
+    // so the image is flipped on the way.
+    static void rgbaToYuv420(const std::uint8_t* rgba, int width, int height, std::uint8_t* yuv) {
+        std::uint8_t* yPlane = yuv;
+        std::uint8_t* uPlane = yPlane + std::size_t(width) * height;
+        std::uint8_t* vPlane = uPlane + std::size_t(width / 2) * (height / 2);
+        const std::size_t stride = std::size_t(width) * 4;
+
+        for (int y = 0; y < height; y += 2) {
+            const std::uint8_t* row0 = rgba + std::size_t(height - 1 - y) * stride;
+            const std::uint8_t* row1 = row0 - stride;
+            std::uint8_t* out0 = yPlane + std::size_t(y) * width;
+            std::uint8_t* out1 = out0 + width;
+            std::uint8_t* u = uPlane + std::size_t(y / 2) * (width / 2);
+            std::uint8_t* v = vPlane + std::size_t(y / 2) * (width / 2);
+
+            for (int x = 0; x < width; x += 2) {
+                const std::uint8_t* p[4] = { row0 + x * 4, row0 + x * 4 + 4, row1 + x * 4, row1 + x * 4 + 4 };
+                int r = 0, g = 0, b = 0;
+                for (int k = 0; k < 4; ++k) {
+                    int luma = (19595 * p[k][0] + 38470 * p[k][1] + 7471 * p[k][2] + 32768) >> 16;
+                    (k < 2 ? out0 : out1)[x + (k & 1)] = std::uint8_t(luma);
+                    r += p[k][0]; g += p[k][1]; b += p[k][2];
+                }
+                r = (r + 2) >> 2; g = (g + 2) >> 2; b = (b + 2) >> 2;
+
+                // 0.5 is taken as 32767/65536 rather than 32768: with the exact
+                // value a saturated blue (U) or red (V) lands on 256 and wraps to 0
+                u[x / 2] = std::uint8_t((-11059 * r - 21709 * g + 32767 * b + (128 << 16) + 32768) >> 16);
+                v[x / 2] = std::uint8_t(( 32767 * r - 27439 * g -  5329 * b + (128 << 16) + 32768) >> 16);
+            }
+        }
+    }
+
+    // ─── Encode pipeline ───
+    // A ring of frame slots between the GL thread, the encode pool and one
+    // writer. Slots are reused strictly in frame order, so the writer only
+    // ever waits on the oldest frame and memory stays bounded.
+    class FramePipeline {
+    public:
+        FramePipeline(FILE* out, int width, int height, std::uint64_t frameCount, unsigned int threads)
+            : out_(out), width_(width), height_(height), frameCount_(frameCount),
+              pool_(std::make_unique<ThreadPool>(threads)), slots_(pool_->threadCount() * 2 + 2) {
+            for (auto& slot : slots_) {
+                slot.rgba.resize(std::size_t(width) * height * 4);
+                slot.yuv.resize(std::size_t(width) * height * 3 / 2);
+            }
+            writer_ = std::thread([this] { writeLoop(); });
+        }
+
+        ~FramePipeline() {
+            finish();
+        }
+
+        // Blocks until the slot for `frame` has been written out
+        std::uint8_t* acquire(std::uint64_t frame) {
+            Slot& slot = slots_[frame % slots_.size()];
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [&] { return slot.state == State::Free; });
+            slot.frame = frame;
+            return slot.rgba.data();
+        }
+
+        void submit(std::uint64_t frame) {
+            Slot& slot = slots_[frame % slots_.size()];
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                slot.state = State::Filled;
+            }
+            pool_->submit([this, &slot] {
+                rgbaToYuv420(slot.rgba.data(), width_, height_, slot.yuv.data());
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    slot.state = State::Encoded;
+                }
+                cv_.notify_all();
+            });
+        }
+
+        // Waits for every submitted frame to reach the output
+        bool finish() {
+            if (writer_.joinable())
+                writer_.join();
+            pool_.reset();   // joins the encoders before the slots and cv go away
+            return !failed_;
+        }
+
+    private:
+        enum class State { Free, Filled, Encoded };
+
+        struct Slot {
+            std::vector<std::uint8_t> rgba;
+            std::vector<std::uint8_t> yuv;
+            std::uint64_t frame = 0;
+            State state = State::Free;
+        };
+
+        void writeLoop() {
+            for (std::uint64_t frame = 0; frame < frameCount_; ++frame) {
+                Slot& slot = slots_[frame % slots_.size()];
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    cv_.wait(lock, [&] { return slot.state == State::Encoded && slot.frame == frame; });
+                }
+
+                if (!failed_) {
+                    std::fwrite("FRAME\n", 1, 6, out_);
+                    if (std::fwrite(slot.yuv.data(), 1, slot.yuv.size(), out_) != slot.yuv.size()) {
+                        std::cerr << "Offline render: failed to write video frame " << frame << "\n";
+                        failed_ = true;   // keep draining so the GL thread never blocks
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    slot.state = State::Free;
+                }
+                cv_.notify_all();
+            }
+        }
+
+        FILE* out_;
+        int width_, height_;
+        std::uint64_t frameCount_;
+
+        std::unique_ptr<ThreadPool> pool_;
+        std::vector<Slot> slots_;
+        std::thread writer_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        bool failed_ = false;   // writer thread only until finish() joins it
+    };
+
+    // ─── Timeline ───
+    static float timelineEnd() {
+        return TimelineIndex::endMs() / 1000.0f;
+    }
+
+    // Starts and stops tracks by region exactly like the interactive loop,
+    // but evaluated once per mixer block
+    static void updateTrackRegions(float time) {
+        for (auto& track : Timeline::timelineTracks) {
+            bool inRegion = (time >= track->startTime) && (time < track->startTime + track->duration);
+
+            if (inRegion && !track->playing)
+                track->playTrack(time);
+            else if (!inRegion && track->playing)
+                track->stopTrack();
+        }
+    }
+
+    // Offline there is no deadline, so wait for the streamer rather than drop samples
+    static void waitForTracks(ma_uint32 frames) {
+        auto deadline = std::chrono::steady_clock::now() + decodeStallTimeout;
+        while (!AudioEngine::tracksReady(frames)) {
+            TrackStreamer::wake();
+            if (std::chrono::steady_clock::now() > deadline) {
+                std::cerr << "Offline render: decoding stalled, mixing what is buffered\n";
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    bool render(const Settings& requested) {
+        Settings s = requested;
+        s.width = (std::max)(2, s.width & ~1);
+        s.height = (std::max)(2, s.height & ~1);
+        s.fps = (std::max)(1, s.fps);
+        s.start = (std::max)(0.0f, s.start);
+        float end = s.end >= 0.0f ? s.end : timelineEnd();
+
+        if (end <= s.start) {
+            std::cerr << "Offline render: nothing to render between " << s.start << "s and " << end << "s\n";
+            return false;
+        }
+        if (s.videoPath == "-" && s.audioPath == "-") {
+            std::cerr << "Offline render: only one of video and audio can go to stdout\n";
+            return false;
+        }
+
+        const std::uint64_t frameCount = std::uint64_t(std::ceil(double(end - s.start) * s.fps - 1e-6));
+        auto audioFrameOf = [&](std::uint64_t videoFrame) {
+            return videoFrame * AudioEngine::sampleRate / std::uint64_t(s.fps);
+        };
+
+        FILE* video = openOutput(s.videoPath);
+        if (!video) {
+            std::cerr << "Offline render: cannot open " << s.videoPath << "\n";
+            return false;
+        }
+        FILE* audio = nullptr;
+        if (!s.audioPath.empty()) {
+            audio = openOutput(s.audioPath);
+            if (!audio) {
+                std::cerr << "Offline render: cannot open " << s.audioPath << "\n";
+                closeOutput(video);
+                return false;
+            }
+            writeWavHeader(audio, audioFrameOf(frameCount));
+        }
+        std::fprintf(video, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", s.width, s.height, s.fps);
+
+        TRACE_INFO("offline render: {} frames at {}x{}, {} fps", frameCount, s.width, s.height, s.fps);
+
+        // ─── Take the tracks over from the device ───
+        const float savedTime = GlobalTransport::currentTime;
+        GlobalTransport::isPlaying = false;
+        AudioEngine::setOffline(true);
+        for (auto& track : Timeline::timelineTracks)
+            track->stopTrack();
+        const float savedLookAhead = TrackStreamer::lookAheadSeconds.exchange(TrackStreamer::maxLookAheadSeconds);
+        for (auto& scene : Timeline::scenes)
+            scene->resetObjectAnimations();
+
+        const std::size_t frameBytes = std::size_t(s.width) * s.height * 4;
+        std::unique_ptr<SoftwareRasterizer> raster;
+        GLuint pbo[2] = {};
+        if (s.software) {
+            raster = std::make_unique<SoftwareRasterizer>(s.rasterThreads);
+        }
+        else {
+            glGenBuffers(2, pbo);
+            for (GLuint buffer : pbo) {
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+                glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+            }
+        }
+
+        FramePipeline pipeline(video, s.width, s.height, frameCount, s.encodeThreads);
+        std::vector<float> mix(std::size_t(AudioEngine::maxBlockFrames) * AudioEngine::outputChannels);
+        std::uint64_t audioPos = 0;
+        bool audioFailed = false;
+
+        auto mixTo = [&](std::uint64_t target) {
+            while (audioPos < target) {
+                ma_uint32 block = ma_uint32((std::min)(target - audioPos, std::uint64_t(AudioEngine::maxBlockFrames)));
+                updateTrackRegions(float(s.start + double(audioPos) / AudioEngine::sampleRate));
+                waitForTracks(block);
+                AudioEngine::render(mix.data(), block);
+
+                std::size_t samples = std::size_t(block) * AudioEngine::outputChannels;
+                if (audio && !audioFailed && std::fwrite(mix.data(), sizeof(float), samples, audio) != samples) {
+                    std::cerr << "Offline render: failed to write audio\n";
+                    audioFailed = true;
+                }
+                audioPos += block;
+            }
+        };
+
+        // Maps the pixel buffer filled one frame ago, so the GPU never stalls on it
+        auto collect = [&](std::uint64_t frame) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[frame % 2]);
+            std::uint8_t* dst = pipeline.acquire(frame);
+            const void* pixels = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, frameBytes, GL_MAP_READ_BIT);
+            if (pixels) {
+                std::memcpy(dst, pixels, frameBytes);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            }
+            else {
+                std::memset(dst, 0, frameBytes);
+            }
+            pipeline.submit(frame);
+        };
+
+        auto started = std::chrono::steady_clock::now();
+
+        for (std::uint64_t i = 0; i < frameCount; ++i) {
+            mixTo(audioFrameOf(i));
+
+            const float t = float(s.start + double(i) / s.fps);
+            GlobalTransport::currentTime = t;
+            Timeline::currentScene = Timeline::sceneAt(t);
+            if (Timeline::currentScene)
+                AnimationSystem::update(*Timeline::currentScene);
+            for (auto& track : Timeline::timelineTracks)
+                track->updateMappings();
+
+            if (raster) {
+                // Already resolved in memory; no readback latency to hide
+                Canvas::renderOffscreen(Timeline::currentScene.get(), s.width, s.height, raster.get());
+                std::memcpy(pipeline.acquire(i), raster->pixels(), frameBytes);
+                pipeline.submit(i);
+                continue;
+            }
+
+            Canvas::renderOffscreen(Timeline::currentScene.get(), s.width, s.height);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo[i % 2]);
+            glReadPixels(0, 0, s.width, s.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+            if (i > 0)
+                collect(i - 1);
+        }
+        if (!raster && frameCount > 0)
+            collect(frameCount - 1);
+        mixTo(audioFrameOf(frameCount));
+
+        if (!raster) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+            glDeleteBuffers(2, pbo);
+        }
+
+        bool ok = pipeline.finish() && !audioFailed;
+        ok = closeOutput(video) && ok;
+        ok = closeOutput(audio) && ok;
+
+        // ─── Hand the tracks back ───
+        for (auto& track : Timeline::timelineTracks)
+            track->stopTrack();
+        TrackStreamer::lookAheadSeconds.store(savedLookAhead);
+        AudioEngine::setOffline(false);
+        GlobalTransport::currentTime = savedTime;
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        double length = double(frameCount) / s.fps;
+        std::cerr << "Rendered " << frameCount << " frames (" << length << "s) in " << seconds << "s, "
+            << (seconds > 0.0 ? length / seconds : 0.0) << "x real time\n";
+        return ok;
+    }
+}
@@ -0,0 +1,238 @@
+#include "PcmCache.h"
+#include "ImportJobs.h"
+#include "Timeline.h"
+#include "TimelineTrack.h"
+#include "TrackSet.h"
+#include "Trace.h"
+#include "miniaudio.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <map>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// ─── PcmBuffer ───
+
+static std::size_t sampleBytes(PcmBuffer::Format format) {
+    return format == PcmBuffer::Format::Int16 ? sizeof(std::int16_t) : sizeof(float);
+}
+
+PcmBuffer::PcmBuffer(Format format, std::uint32_t channels, std::uint64_t frames)
+    : format_(format), channels_(channels), frames_(frames) {
+    const std::size_t raw = static_cast<std::size_t>(frames) * channels * sampleBytes(format);
+    bytes_ = (raw + pageBytes - 1) / pageBytes * pageBytes;
+    if (bytes_ == 0)
+        return;
+#ifdef _WIN32
+    data_ = _aligned_malloc(bytes_, pageBytes);
+#else
+    if (posix_memalign(&data_, pageBytes, bytes_) != 0)
+        data_ = nullptr;
+#endif
+}
+
+PcmBuffer::~PcmBuffer() {
+#ifdef _WIN32
+    _aligned_free(data_);
+#else
+    std::free(data_);
+#endif
+}
+
+std::uint64_t PcmBuffer::read(std::uint64_t frame, float* out, std::uint64_t frames) const {
+    if (frame >= frames_)
+        return 0;
+    frames = (std::min)(frames, frames_ - frame);
+    const std::size_t samples = static_cast<std::size_t>(frames) * channels_;
+    const std::size_t first = static_cast<std::size_t>(frame) * channels_;
+
+    if (format_ == Format::Float32) {
+        std::memcpy(out, static_cast<const float*>(data_) + first, samples * sizeof(float));
+    }
+    else {
+        const std::int16_t* in = static_cast<const std::int16_t*>(data_) + first;
+        for (std::size_t i = 0; i < samples; ++i)
+            out[i] = in[i] * (1.0f / 32768.0f);
+    }
+    return frames;
+}
+
+// ─── Cache ───
+
+namespace PcmCache {
+    std::atomic<bool> enabled{ false };
+    std::atomic<PcmBuffer::Format> format{ PcmBuffer::Format::Float32 };
+    std::atomic<std::size_t> budgetBytes{ std::size_t(1) << 30 };
+
+    using BufferFuture = std::shared_future<std::shared_ptr<const PcmBuffer>>;
+
+    static std::mutex mutex;
+    static std::map<std::string, BufferFuture> entries;   // first decoder fills, the rest wait
+    static std::uint64_t frameTick = 0;                   // UI thread only
+
+    static std::shared_ptr<const PcmBuffer> decode(const std::string& path, std::uint32_t sampleRate,
+        std::uint32_t channels, PcmBuffer::Format fmt) {
+        ma_decoder_config config = ma_decoder_config_init(
+            fmt == PcmBuffer::Format::Int16 ? ma_format_s16 : ma_format_f32, channels, sampleRate);
+        ma_decoder decoder;
+        if (ma_decoder_init_file(path.c_str(), &config, &decoder) != MA_SUCCESS)
+            return nullptr;
+
+        ma_uint64 length = 0;
+        ma_decoder_get_length_in_pcm_frames(&decoder, &length);
+        const std::size_t needed = static_cast<std::size_t>(length) * channels * sampleBytes(fmt);
+        if (length == 0 || needed > budgetBytes.load(std::memory_order_relaxed)) {
+            ma_decoder_uninit(&decoder);
+            return nullptr;   // unknown length or too big: stream it
+        }
+
+        auto buffer = std::make_shared<PcmBuffer>(fmt, channels, length);
+        if (!buffer->valid()) {
+            ma_decoder_uninit(&decoder);
+            return nullptr;
+        }
+
+        ma_uint64 framesRead = 0;
+        ma_decoder_read_pcm_frames(&decoder, buffer->data(), length, &framesRead);
+        ma_decoder_uninit(&decoder);
+        if (framesRead == 0)
+            return nullptr;
+        buffer->setFrameCount(framesRead);
+        return buffer;
+    }
+
+    // Starts with the path, so every entry of a file can be found by prefix
+    static std::string keyFor(const std::string& path, std::uint32_t sampleRate,
+        std::uint32_t channels, PcmBuffer::Format fmt) {
+        return path + '|' + std::to_string(sampleRate) + '|' + std::to_string(channels)
+            + (fmt == PcmBuffer::Format::Int16 ? "|s16" : "|f32");
+    }
+
+    static bool keyIsFor(const std::string& key, const std::string& path) {
+        return key.size() > path.size() && key.compare(0, path.size(), path) == 0
+            && key[path.size()] == '|';
+    }
+
+    std::shared_ptr<const PcmBuffer> acquire(const std::string& path, std::uint32_t sampleRate,
+        std::uint32_t channels) {
+        if (!enabled.load(std::memory_order_relaxed))
+            return nullptr;
+
+        const PcmBuffer::Format fmt = format.load(std::memory_order_relaxed);
+        const std::string key = keyFor(path, sampleRate, channels, fmt);
+
+        std::promise<std::shared_ptr<const PcmBuffer>> promise;
+        BufferFuture future;
+        bool decoder = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = entries.find(key);
+            if (it != entries.end()) {
+                future = it->second;
+            }
+            else {
+                future = promise.get_future().share();
+                entries.emplace(key, future);
+                decoder = true;
+            }
+        }
+
+        if (decoder) {
+            auto buffer = decode(path, sampleRate, channels, fmt);
+            if (!buffer) {
+                std::lock_guard<std::mutex> lock(mutex);
+                entries.erase(key);
+            }
+            promise.set_value(std::move(buffer));
+        }
+        return future.get();
+    }
+
+    // Ready buffers only; one still decoding is not resident yet
+    static std::vector<std::pair<std::string, std::shared_ptr<const PcmBuffer>>> snapshot() {
+        std::vector<std::pair<std::string, std::shared_ptr<const PcmBuffer>>> ready;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& [key, future] : entries) {
+            if (future.wait_for(std::chrono::seconds(0)) == std::future_status::ready && future.get())
+                ready.emplace_back(key, future.get());
+        }
+        return ready;
+    }
+
+    std::size_t residentBytes() {
+        std::size_t total = 0;
+        for (auto& [key, buffer] : snapshot())
+            total += buffer->bytes();
+        return total;
+    }
+
+    void update() {
+        ++frameTick;
+
+        std::unordered_set<const PcmBuffer*> playing;
+        for (auto& track : Timeline::timelineTracks) {
+            if (track->pcm && track->playing) {
+                track->pcm->lastUsed.store(frameTick, std::memory_order_relaxed);
+                playing.insert(track->pcm.get());
+            }
+        }
+
+        // An import still in flight may already hold its file's buffer, or be
+        // about to; it stays until the track is published and counted above
+        std::vector<const std::string*> importing;
+        for (auto& import : ImportJobs::active()) {
+            if (import->stage.load(std::memory_order_acquire) != ImportJobs::Stage::Failed)
+                importing.push_back(&import->path);
+        }
+
+        auto ready = snapshot();
+        std::size_t total = 0;
+        for (auto& [key, buffer] : ready)
+            total += buffer->bytes();
+        const std::size_t budget = budgetBytes.load(std::memory_order_relaxed);
+        if (total <= budget)
+            return;
+
+        // Coldest first; a buffer a playing or importing track holds stays put
+        std::sort(ready.begin(), ready.end(), [](const auto& a, const auto& b) {
+            return a.second->lastUsed.load(std::memory_order_relaxed) < b.second->lastUsed.load(std::memory_order_relaxed);
+        });
+
+        for (auto& [key, buffer] : ready) {
+            if (total <= budget)
+                break;
+            if (playing.count(buffer.get()))
+                continue;
+            if (std::any_of(importing.begin(), importing.end(),
+                    [&key = key](const std::string* path) { return keyIsFor(key, *path); }))
+                continue;
+
+            for (auto& track : Timeline::timelineTracks) {
+                if (track->pcm == buffer)
+                    track->detachPcm();
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                entries.erase(key);
+            }
+            total -= buffer->bytes();
+            TRACE_INFO("Evicted a {} byte PCM buffer", buffer->bytes());
+
+            // The mixer may still be inside a block reading it
+            TrackSet::defer(std::move(buffer));
+        }
+    }
+
+    void shutdown() {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries.clear();
+    }
+}
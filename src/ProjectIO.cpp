@@ -0,0 +1,873 @@
+#include "ProjectIO.h"
+#include "Canvas.h"
+#include "Ellipse.h"
+#include "Line.h"
+#include "MappedFile.h"
+#include "MappingsWindow.h"
+#include "Rectangle.h"
+#include "ScenePreloader.h"
+#include "Star.h"
+#include "Timeline.h"
+#include "TimelineIndex.h"
+#include "TimelineTrack.h"
+#include "Trace.h"
+#include "TrackSet.h"
+#include "TrackFeatures.h"
+#include "Triangle.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace ProjectIO {
+
+    static constexpr std::uint32_t formatVersion = 1;
+    static constexpr std::uint32_t none = 0xFFFFFFFFu;   // "no reference" in an index field
+
+    // ─── On-disk records ───
+    // Every field is 4 bytes wide, so records pack without padding and can be
+    // read in place from the mapping. `first`/`count` pairs are ranges in the
+    // next table down; ranges are contiguous because the writer emits each
+    // owner's children in one go.
+    struct StringRef {
+        std::uint32_t offset;                // into the string blob
+        std::uint32_t length;
+    };
+
+    struct SceneRecord {
+        float startMs, endMs;
+        std::uint32_t color;                 // ImU32
+        std::uint32_t firstObject, objectCount;
+    };
+
+    struct ObjectRecord {
+        StringRef id;
+        std::int32_t type;                   // ObjectType
+        float position[3], rotation[3], scale[3];
+        float hsva[4];
+        float opacity;
+        StringRef texture;
+        float size[3];
+        float stroke;
+        std::uint32_t filled;
+        std::uint32_t loopType;              // how the object steps through each parameter's animations
+        std::uint32_t firstAnimation, animationCount;   // by parameter, then slot
+    };
+
+    struct AnimationRecord {
+        std::uint32_t parameter;             // GraphicParameter
+        std::uint32_t loopType;
+        std::uint32_t easing;
+        std::uint32_t hasTrigger;
+        std::uint32_t firstPoint, pointCount;
+    };
+
+    struct PointRecord {
+        float value[2];
+        float durationMs;
+        std::uint32_t loopType;              // how the point steps through its paths
+        std::uint32_t firstPath, pathCount;
+    };
+
+    struct PathRecord {
+        float start[2], end[2];
+        std::uint32_t easing;
+        std::uint32_t endPoint;              // point whose value the path ends on, or none
+    };
+
+    struct TrackRecord {
+        StringRef filePath;                  // relative to the project file where possible
+        StringRef displayName;
+        float startTime;                     // seconds
+        std::uint32_t color;
+        std::uint32_t muted;
+        float smoothingAlpha;                // raw one-pole coefficient
+        std::uint32_t firstMapping, mappingCount;
+    };
+
+    struct MappingRecord {
+        std::uint32_t type;                  // MapType
+        std::uint32_t audioParameter;
+        std::uint32_t graphicParameter;
+        std::uint32_t laneY;
+        std::uint32_t object;
+        float input[2], output[2];           // sync only
+        float threshold;                     // trigger only
+        std::uint32_t greaterThan;
+        std::uint32_t animation;             // trigger: slot in the parameter's animation list
+    };
+
+    static_assert(sizeof(SceneRecord) == 20, "project records must stay packed");
+    static_assert(sizeof(ObjectRecord) == 108, "project records must stay packed");
+    static_assert(sizeof(AnimationRecord) == 24, "project records must stay packed");
+    static_assert(sizeof(PointRecord) == 24, "project records must stay packed");
+    static_assert(sizeof(PathRecord) == 24, "project records must stay packed");
+    static_assert(sizeof(TrackRecord) == 40, "project records must stay packed");
+    static_assert(sizeof(MappingRecord) == 48, "project records must stay packed");
+
+    enum Table : std::uint32_t {
+        Strings, Scenes, Objects, Animations, Points, Paths, Tracks, Mappings, TableCount
+    };
+
+    struct TableRef {
+        std::uint64_t offset;                // from the start of the file, 8-byte aligned
+        std::uint32_t count;
+        std::uint32_t stride;                // record size as written; 1 for the string blob
+    };
+
+    // On-disk layout: this header, then each table in Table order
+    struct Header {
+        char          magic[4];
+        std::uint32_t version;
+        std::uint64_t fileSize;
+        std::uint32_t tableCount;            // a newer writer may list more tables than we know
+        std::uint32_t reserved;
+        TableRef      tables[TableCount];
+    };
+    static_assert(sizeof(Header) == 24 + 16 * TableCount, "project header must stay packed");
+
+    static bool littleEndianHost() {
+        const std::uint32_t probe = 1;
+        std::uint8_t first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+    // ─── Flattening the timeline ───
+
+    // The whole project as it is laid out on disk
+    struct Tables {
+        std::string strings;
+        std::vector<SceneRecord> scenes;
+        std::vector<ObjectRecord> objects;
+        std::vector<AnimationRecord> animations;
+        std::vector<PointRecord> points;
+        std::vector<PathRecord> paths;
+        std::vector<TrackRecord> tracks;
+        std::vector<MappingRecord> mappings;
+
+        StringRef add(const std::string& s) {
+            StringRef ref{ static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(s.size()) };
+            strings += s;
+            return ref;
+        }
+        std::string get(StringRef ref) const { return strings.substr(ref.offset, ref.length); }
+    };
+
+    static std::uint32_t index32(std::size_t i) { return static_cast<std::uint32_t>(i); }
+
+    static void copy2(float* dst, const glm::vec2& v) { dst[0] = v.x; dst[1] = v.y; }
+    static void copy3(float* dst, const glm::vec3& v) { dst[0] = v.x; dst[1] = v.y; dst[2] = v.z; }
+
+    // Audio files are stored relative to the project so a show can be moved as a folder
+    static std::string portablePath(const std::string& file, const std::filesystem::path& projectDir) {
+        std::error_code ec;
+        std::filesystem::path relative = std::filesystem::relative(file, projectDir, ec);
+        if (ec || relative.empty())
+            return std::filesystem::path(file).generic_string();
+        return relative.generic_string();
+    }
+
+    static Tables flatten(const std::filesystem::path& projectDir) {
+        Tables t;
+
+        // Paths may end on a point of another animation (duplicated objects
+        // share them), so end points are resolved once every point is numbered
+        std::unordered_map<const GraphicObject*, std::uint32_t> objectIndex;
+        std::unordered_map<const AnimationPoint*, std::uint32_t> pointIndex;
+        std::vector<std::pair<std::size_t, const AnimationPoint*>> pathEnds;
+
+        for (const auto& scene : Timeline::scenes) {
+            SceneRecord sr{ scene->startTime, scene->endTime, scene->color, index32(t.objects.size()), 0 };
+
+            for (const auto& obj : scene->objects) {
+                objectIndex[obj.get()] = index32(t.objects.size());
+
+                ObjectRecord o{};
+                o.id = t.add(obj->getId());
+                o.type = static_cast<std::int32_t>(obj->getObjectType());
+                copy3(o.position, obj->getTransform().position);
+                copy3(o.rotation, obj->getTransform().rotation);
+                copy3(o.scale, obj->getTransform().scale);
+                const Material& m = obj->getMaterial();
+                for (int c = 0; c < 4; ++c)
+                    o.hsva[c] = m.hsva[c];
+                o.opacity = m.opacity;
+                o.texture = t.add(obj->getTexture());
+                copy3(o.size, obj->getSize());
+                o.stroke = obj->getStroke();
+                o.filled = obj->isFilled() ? 1 : 0;
+                o.loopType = static_cast<std::uint32_t>(obj->getLoopType());
+                o.firstAnimation = index32(t.animations.size());
+
+                for (std::size_t p = 0; p < static_cast<std::size_t>(GraphicParameter::COUNT); ++p) {
+                    for (const auto& anim : obj->getAnimations(p)) {
+                        AnimationRecord a{};
+                        a.parameter = index32(p);
+                        a.loopType = static_cast<std::uint32_t>(anim->getLoopType());
+                        a.easing = static_cast<std::uint32_t>(anim->getEasingType());
+                        a.hasTrigger = anim->hasTrigger() ? 1 : 0;
+                        a.firstPoint = index32(t.points.size());
+
+                        for (const auto& point : anim->getPoints()) {
+                            pointIndex[point.get()] = index32(t.points.size());
+
+                            PointRecord pr{};
+                            copy2(pr.value, point->getValue());
+                            pr.durationMs = point->getDuration();
+                            pr.loopType = static_cast<std::uint32_t>(point->getLoopType());
+                            pr.firstPath = index32(t.paths.size());
+
+                            for (const auto& path : point->getPaths()) {
+                                PathRecord r{};
+                                copy2(r.start, path->getStart());
+                                copy2(r.end, path->getEnd());
+                                r.easing = static_cast<std::uint32_t>(path->getEasingType());
+                                r.endPoint = none;
+                                if (auto end = path->getEndPoint())
+                                    pathEnds.emplace_back(t.paths.size(), end.get());
+                                t.paths.push_back(r);
+                            }
+                            pr.pathCount = index32(t.paths.size()) - pr.firstPath;
+                            t.points.push_back(pr);
+                        }
+                        a.pointCount = index32(t.points.size()) - a.firstPoint;
+                        t.animations.push_back(a);
+                    }
+                }
+                o.animationCount = index32(t.animations.size()) - o.firstAnimation;
+                t.objects.push_back(o);
+            }
+
+            sr.objectCount = index32(t.objects.size()) - sr.firstObject;
+            t.scenes.push_back(sr);
+        }
+
+        for (const auto& [path, end] : pathEnds) {
+            auto it = pointIndex.find(end);
+            if (it != pointIndex.end())
+                t.paths[path].endPoint = it->second;
+        }
+
+        for (const auto& track : Timeline::timelineTracks) {
+            TrackRecord tr{};
+            tr.filePath = t.add(portablePath(track->filePath, projectDir));
+            tr.displayName = t.add(track->displayName);
+            tr.startTime = track->startTime;
+            tr.color = track->color;
+            tr.muted = track->muted ? 1 : 0;
+            tr.smoothingAlpha = track->analyzer.getSmoothingCoefficient();
+            tr.firstMapping = index32(t.mappings.size());
+
+            for (std::size_t ap = 0; ap < track->mappings.size(); ++ap) {
+                for (const auto& mapping : track->mappings[ap]) {
+                    // Mappings whose object was deleted are dropped, as MappingTable does
+                    auto it = objectIndex.find(mapping->getMappedObject().get());
+                    if (it == objectIndex.end())
+                        continue;
+
+                    MappingRecord r{};
+                    r.type = static_cast<std::uint32_t>(mapping->getMapType());
+                    r.audioParameter = index32(ap);
+                    r.graphicParameter = static_cast<std::uint32_t>(mapping->getGraphicParameter());
+                    r.laneY = mapping->getGParamY() ? 1 : 0;
+                    r.object = it->second;
+                    r.animation = none;
+                    if (mapping->getMapType() == MapType::Sync) {
+                        const auto& sync = static_cast<const SyncMapping&>(*mapping);
+                        copy2(r.input, sync.getInputMapping());
+                        copy2(r.output, sync.getOutputMapping());
+                    }
+                    else {
+                        const auto& trig = static_cast<const TriggerMapping&>(*mapping);
+                        r.threshold = trig.getThreshold();
+                        r.greaterThan = trig.isGreaterThan() ? 1 : 0;
+                        r.animation = index32(trig.getAnimationIndex());
+                    }
+                    t.mappings.push_back(r);
+                }
+            }
+            tr.mappingCount = index32(t.mappings.size()) - tr.firstMapping;
+            t.tracks.push_back(tr);
+        }
+
+        return t;
+    }
+
+    // ─── Binary writer ───
+
+    struct Blob {
+        const void* data;
+        std::size_t bytes;
+        std::uint32_t count;
+        std::uint32_t stride;
+    };
+
+    template <typename R>
+    static Blob blob(const std::vector<R>& rows) {
+        return { rows.data(), rows.size() * sizeof(R), index32(rows.size()), index32(sizeof(R)) };
+    }
+
+    static bool writeBinary(const std::string& path, const Tables& t) {
+        const Blob blobs[TableCount] = {
+            { t.strings.data(), t.strings.size(), index32(t.strings.size()), 1 },
+            blob(t.scenes),
+            blob(t.objects),
+            blob(t.animations),
+            blob(t.points),
+            blob(t.paths),
+            blob(t.tracks),
+            blob(t.mappings),
+        };
+
+        Header header{};
+        std::memcpy(header.magic, "EZPJ", 4);
+        header.version = formatVersion;
+        header.tableCount = TableCount;
+
+        std::uint64_t offset = sizeof(Header);
+        for (std::uint32_t i = 0; i < TableCount; ++i) {
+            offset = (offset + 7) & ~std::uint64_t(7);
+            header.tables[i] = { offset, blobs[i].count, blobs[i].stride };
+            offset += blobs[i].bytes;
+        }
+        header.fileSize = offset;
+
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out)
+                return false;
+
+            static const char zeros[8] = {};
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            std::uint64_t written = sizeof(Header);
+            for (std::uint32_t i = 0; i < TableCount; ++i) {
+                out.write(zeros, static_cast<std::streamsize>(header.tables[i].offset - written));
+                out.write(static_cast<const char*>(blobs[i].data), static_cast<std::streamsize>(blobs[i].bytes));
+                written = header.tables[i].offset + blobs[i].bytes;
+            }
+            if (!out)
+                return false;
+        }
+        // Never leave a half-written project in place of a good one
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool save(const std::string& path) {
+        if (!littleEndianHost()) {
+            std::cerr << "Project files are little-endian; saving is not supported on this machine\n";
+            return false;
+        }
+
+        const auto projectDir = std::filesystem::absolute(path).parent_path();
+        if (!writeBinary(path, flatten(projectDir))) {
+            std::cerr << "Could not write project " << path << "\n";
+            return false;
+        }
+        TRACE_INFO("Saved project with {} scenes and {} tracks", Timeline::scenes.size(), Timeline::timelineTracks.size());
+        return true;
+    }
+
+    // ─── Loading ───
+
+    // One table read in place from the mapping
+    template <typename R>
+    struct Rows {
+        const std::uint8_t* base = nullptr;
+        std::uint32_t count = 0;
+        std::uint32_t stride = 0;
+
+        const R& operator[](std::size_t i) const {
+            return *reinterpret_cast<const R*>(base + i * stride);
+        }
+        bool holds(std::uint32_t first, std::uint32_t n) const {
+            return first <= count && n <= count - first;
+        }
+    };
+
+    template <typename R>
+    static bool bindTable(const MappedFile& file, const TableRef& ref, Rows<R>& rows) {
+        // Newer writers may have grown the record; the prefix is what we know
+        if (ref.stride < sizeof(R) || ref.stride % alignof(R) != 0 || ref.offset % alignof(R) != 0)
+            return false;
+        if (ref.offset > file.size() || std::uint64_t(ref.count) * ref.stride > file.size() - ref.offset)
+            return false;
+        rows.base = file.data() + ref.offset;
+        rows.count = ref.count;
+        rows.stride = ref.stride;
+        return true;
+    }
+
+    static std::shared_ptr<GraphicObject> makeObject(ObjectType type, std::string& id) {
+        switch (type) {
+        case ObjectType::Line:      return std::make_shared<LineObject>(type, id);
+        case ObjectType::Rectangle: return std::make_shared<RectangleObject>(type, id);
+        case ObjectType::Ellipse:   return std::make_shared<EllipseObject>(type, id);
+        case ObjectType::Triangle:  return std::make_shared<TriangleObject>(type, id);
+        case ObjectType::Star:      return std::make_shared<StarObject>(type, id);
+        default:                    return nullptr;
+        }
+    }
+
+    static bool below(std::uint32_t value, std::size_t count) { return value < count; }
+
+    // Everything a project builds before it replaces the live timeline
+    struct Loaded {
+        std::vector<std::shared_ptr<Scene>> scenes;
+        std::vector<std::unique_ptr<TimelineTrack>> tracks;
+
+        ~Loaded() {
+            for (auto& track : tracks)
+                track->unloadTrack();
+        }
+    };
+
+    // Builds the runtime graph table by table, bottom-up, checking every
+    // index as it goes. Returns false on the first malformed record.
+    static bool build(const MappedFile& file, const std::filesystem::path& projectDir, Loaded& out) {
+        Header h;
+        std::memcpy(&h, file.data(), sizeof(h));
+
+        Rows<char> strings;
+        Rows<SceneRecord> sceneRows;
+        Rows<ObjectRecord> objectRows;
+        Rows<AnimationRecord> animationRows;
+        Rows<PointRecord> pointRows;
+        Rows<PathRecord> pathRows;
+        Rows<TrackRecord> trackRows;
+        Rows<MappingRecord> mappingRows;
+        if (!bindTable(file, h.tables[Strings], strings)
+            || !bindTable(file, h.tables[Scenes], sceneRows)
+            || !bindTable(file, h.tables[Objects], objectRows)
+            || !bindTable(file, h.tables[Animations], animationRows)
+            || !bindTable(file, h.tables[Points], pointRows)
+            || !bindTable(file, h.tables[Paths], pathRows)
+            || !bindTable(file, h.tables[Tracks], trackRows)
+            || !bindTable(file, h.tables[Mappings], mappingRows))
+            return false;
+
+        auto text = [&](StringRef ref, std::string& s) {
+            if (!strings.holds(ref.offset, ref.length))
+                return false;
+            s.assign(reinterpret_cast<const char*>(strings.base) + ref.offset, ref.length);
+            return true;
+        };
+
+        constexpr auto parameterCount = static_cast<std::uint32_t>(GraphicParameter::COUNT);
+        constexpr auto loopCount = static_cast<std::uint32_t>(LoopType::COUNT);
+        constexpr auto easingCount = static_cast<std::uint32_t>(EasingType::COUNT);
+
+        // Points first: paths may end on any of them
+        std::vector<std::shared_ptr<AnimationPoint>> points(pointRows.count);
+        for (std::uint32_t i = 0; i < pointRows.count; ++i) {
+            const PointRecord& r = pointRows[i];
+            if (!below(r.loopType, loopCount) || !pathRows.holds(r.firstPath, r.pathCount))
+                return false;
+            points[i] = std::make_shared<AnimationPoint>(glm::vec2(r.value[0], r.value[1]), r.durationMs);
+            points[i]->setLoopType(static_cast<LoopType>(r.loopType));
+        }
+
+        for (std::uint32_t i = 0; i < pointRows.count; ++i) {
+            const PointRecord& owner = pointRows[i];
+            for (std::uint32_t k = owner.firstPath; k < owner.firstPath + owner.pathCount; ++k) {
+                const PathRecord& r = pathRows[k];
+                if (!below(r.easing, easingCount) || (r.endPoint != none && !below(r.endPoint, points.size())))
+                    return false;
+
+                auto path = std::make_shared<AnimationPath>(glm::vec2(r.start[0], r.start[1]), glm::vec2(r.end[0], r.end[1]));
+                path->setEasingType(static_cast<EasingType>(r.easing));
+                points[i]->addPath(path);
+                if (r.endPoint != none) {
+                    path->setEndPoint(points[r.endPoint]);
+                    points[r.endPoint]->addAssociatedPath(path);
+                }
+            }
+        }
+
+        std::vector<std::shared_ptr<Animation>> animations(animationRows.count);
+        for (std::uint32_t i = 0; i < animationRows.count; ++i) {
+            const AnimationRecord& r = animationRows[i];
+            if (!below(r.parameter, parameterCount) || !below(r.loopType, loopCount) || !below(r.easing, easingCount)
+                || r.pointCount == 0 || !pointRows.holds(r.firstPoint, r.pointCount))
+                return false;
+
+            std::shared_ptr<AnimationPoint> first = points[r.firstPoint];
+            animations[i] = std::make_shared<Animation>(first);
+            for (std::uint32_t p = r.firstPoint + 1; p < r.firstPoint + r.pointCount; ++p)
+                animations[i]->addPoint(points[p]);
+            animations[i]->setLoopType(static_cast<LoopType>(r.loopType));
+            animations[i]->setEasingType(static_cast<EasingType>(r.easing));
+            animations[i]->setTrigger(r.hasTrigger != 0);
+            animations[i]->setTotalDuration();
+        }
+
+        std::vector<std::shared_ptr<GraphicObject>> objects(objectRows.count);
+        std::string id;
+        for (std::uint32_t i = 0; i < objectRows.count; ++i) {
+            const ObjectRecord& r = objectRows[i];
+            std::string texture;
+            if (!text(r.id, id) || !text(r.texture, texture) || !below(r.loopType, loopCount)
+                || !animationRows.holds(r.firstAnimation, r.animationCount))
+                return false;
+
+            auto obj = makeObject(static_cast<ObjectType>(r.type), id);
+            if (!obj)
+                return false;
+
+            obj->setPosition({ r.position[0], r.position[1], r.position[2] });
+            obj->setRotation({ r.rotation[0], r.rotation[1], r.rotation[2] });
+            obj->setScale(glm::vec3{ r.scale[0], r.scale[1], r.scale[2] });
+            obj->setHSVA({ r.hsva[0], r.hsva[1], r.hsva[2], r.hsva[3] });
+            obj->setOpacity(r.opacity);
+            obj->setTexture(texture);
+            obj->setSize({ r.size[0], r.size[1], r.size[2] });
+            obj->setStroke(r.stroke);
+            obj->setFilled(r.filled != 0);
+            obj->setLoopType(static_cast<LoopType>(r.loopType));
+
+            for (std::uint32_t a = r.firstAnimation; a < r.firstAnimation + r.animationCount; ++a)
+                obj->add_animation(animations[a], animationRows[a].parameter);
+            objects[i] = std::move(obj);
+        }
+
+        out.scenes.reserve(sceneRows.count);
+        for (std::uint32_t i = 0; i < sceneRows.count; ++i) {
+            const SceneRecord& r = sceneRows[i];
+            if (!objectRows.holds(r.firstObject, r.objectCount))
+                return false;
+
+            auto scene = std::make_shared<Scene>(r.startMs, r.endMs, r.color);
+            scene->objects.assign(objects.begin() + r.firstObject, objects.begin() + r.firstObject + r.objectCount);
+            out.scenes.push_back(std::move(scene));
+        }
+
+        out.tracks.reserve(trackRows.count);
+        for (std::uint32_t i = 0; i < trackRows.count; ++i) {
+            const TrackRecord& r = trackRows[i];
+            std::string file, name;
+            if (!text(r.filePath, file) || !text(r.displayName, name)
+                || !mappingRows.holds(r.firstMapping, r.mappingCount))
+                return false;
+
+            auto track = std::make_unique<TimelineTrack>();
+            for (std::uint32_t k = r.firstMapping; k < r.firstMapping + r.mappingCount; ++k) {
+                const MappingRecord& m = mappingRows[k];
+                if (!below(m.type, static_cast<std::uint32_t>(MapType::COUNT))
+                    || !below(m.audioParameter, static_cast<std::uint32_t>(AudioParameter::COUNT))
+                    || !below(m.graphicParameter, parameterCount) || !below(m.object, objects.size()))
+                    return false;
+
+                const auto& obj = objects[m.object];
+                const auto ap = static_cast<AudioParameter>(m.audioParameter);
+                const auto gp = static_cast<GraphicParameter>(m.graphicParameter);
+                std::shared_ptr<Mapping> mapping;
+                if (static_cast<MapType>(m.type) == MapType::Sync) {
+                    auto sync = std::make_shared<SyncMapping>(obj, ap, gp, MapType::Sync, m.laneY != 0);
+                    sync->setMapping({ m.input[0], m.input[1] }, { m.output[0], m.output[1] });
+                    obj->setMapped(static_cast<int>(m.graphicParameter), m.laneY != 0);
+                    mapping = sync;
+                }
+                else {
+                    if (!below(m.animation, obj->getAnimations(m.graphicParameter).size()))
+                        return false;
+                    auto trig = std::make_shared<TriggerMapping>(obj, ap, gp, m.animation, MapType::Trigger);
+                    trig->setThreshold(m.threshold, m.greaterThan != 0);
+                    mapping = trig;
+                }
+                track->mappings[m.audioParameter].push_back(std::move(mapping));
+            }
+
+            track->displayName = name;
+            track->startTime = r.startTime;
+            track->color = r.color;
+            track->muted = r.muted != 0;
+            track->computeComplementaryColor();
+            track->analyzer.setSmoothingCoefficient(r.smoothingAlpha);   // before loading, so the feature cache matches
+
+            // A missing file keeps its mappings but stays silent, as if it were empty
+            const std::string resolved = (projectDir / std::filesystem::path(file)).lexically_normal().string();
+            if (!track->loadTrack(resolved)) {
+                std::cerr << "Project audio not found: " << resolved << "\n";
+                track->filePath = resolved;
+            }
+            out.tracks.push_back(std::move(track));
+        }
+
+        return true;
+    }
+
+    bool load(const std::string& path) {
+        [[maybe_unused]] const auto started = std::chrono::steady_clock::now();
+
+        if (!littleEndianHost()) {
+            std::cerr << "Project files are little-endian; opening is not supported on this machine\n";
+            return false;
+        }
+
+        MappedFile file;
+        if (!file.open(path)) {
+            std::cerr << "Could not open project " << path << "\n";
+            return false;
+        }
+
+        Header h;
+        if (file.size() < sizeof(Header)) {
+            std::cerr << "Not an ezvz project: " << path << "\n";
+            return false;
+        }
+        std::memcpy(&h, file.data(), sizeof(h));
+        if (std::memcmp(h.magic, "EZPJ", 4) != 0) {
+            std::cerr << "Not an ezvz project: " << path << "\n";
+            return false;
+        }
+        if (h.version > formatVersion) {
+            std::cerr << "Project " << path << " was saved by a newer version (format " << h.version << ")\n";
+            return false;
+        }
+        if (h.tableCount < TableCount || h.fileSize != file.size()) {
+            std::cerr << "Project " << path << " is truncated or damaged\n";
+            return false;
+        }
+
+        Loaded loaded;
+        const auto projectDir = std::filesystem::absolute(path).parent_path();
+        if (!build(file, projectDir, loaded)) {
+            std::cerr << "Project " << path << " is damaged\n";
+            return false;
+        }
+
+        // Swap the new show in; the old tracks are unloaded once the mixer
+        // and streamer have let go of them
+        Timeline::timelineTracks.swap(loaded.tracks);
+        Timeline::scenes.swap(loaded.scenes);
+        TrackSet::publish(std::move(loaded.tracks));
+        TimelineIndex::scenesChanged();
+        TimelineIndex::tracksChanged();
+        ScenePreloader::reset();
+
+        Timeline::currentScene = nullptr;
+        Canvas::selectedObject = nullptr;
+        MappingsWindow::selectedMapping = nullptr;
+        TrackFeatures::selectedTrack = nullptr;
+        MappingEpoch::bump();
+
+        TRACE_INFO("Loaded project with {} scenes and {} tracks in {} ms", Timeline::scenes.size(),
+            Timeline::timelineTracks.size(),
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count());
+        return true;
+    }
+
+    // ─── JSON export ───
+
+    static const char* const loopNames[] = { "Off", "Sequence", "Random" };
+    static const char* const easingNames[] = { "Linear", "EaseIn", "EaseOut", "EaseInOut" };
+
+    static void jsonString(std::ostream& out, const std::string& s) {
+        out << '"';
+        for (unsigned char c : s) {
+            switch (c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out << buf;
+                }
+                else {
+                    out << c;
+                }
+            }
+        }
+        out << '"';
+    }
+
+    // JSON has no NaN or infinity; those export as null
+    static void jsonFloat(std::ostream& out, float v) {
+        if (std::isfinite(v))
+            out << v;
+        else
+            out << "null";
+    }
+
+    static void jsonFloats(std::ostream& out, const float* v, int n) {
+        out << '[';
+        for (int i = 0; i < n; ++i) {
+            out << (i ? ", " : "");
+            jsonFloat(out, v[i]);
+        }
+        out << ']';
+    }
+
+    static void jsonColor(std::ostream& out, std::uint32_t c) {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "\"#%02x%02x%02x%02x\"",
+            (c >> IM_COL32_R_SHIFT) & 0xFF, (c >> IM_COL32_G_SHIFT) & 0xFF,
+            (c >> IM_COL32_B_SHIFT) & 0xFF, (c >> IM_COL32_A_SHIFT) & 0xFF);
+        out << buf;
+    }
+
+    // Nested by ownership, so table order is document order; the "index"
+    // fields and cross-references are the binary table indices
+    static void writeJson(std::ostream& out, const Tables& t) {
+        out.precision(9);   // round-trips every float
+        out << "{\n  \"format\": \"ezvz-project\",\n  \"version\": " << formatVersion << ",\n  \"scenes\": [";
+
+        for (std::size_t s = 0; s < t.scenes.size(); ++s) {
+            const SceneRecord& sc = t.scenes[s];
+            out << (s ? "," : "") << "\n    { \"start\": ";
+            jsonFloat(out, sc.startMs);
+            out << ", \"end\": ";
+            jsonFloat(out, sc.endMs);
+            out << ", \"color\": ";
+            jsonColor(out, sc.color);
+            out << ", \"objects\": [";
+
+            for (std::uint32_t o = sc.firstObject; o < sc.firstObject + sc.objectCount; ++o) {
+                const ObjectRecord& ob = t.objects[o];
+                out << (o > sc.firstObject ? "," : "") << "\n      { \"index\": " << o << ", \"id\": ";
+                jsonString(out, t.get(ob.id));
+                const bool known = ob.type >= 0 && ob.type < static_cast<std::int32_t>(ObjectType::COUNT);
+                out << ", \"type\": \"" << (known ? objectTypeNames[ob.type] : "Unknown") << "\"";
+                out << ",\n        \"position\": "; jsonFloats(out, ob.position, 3);
+                out << ", \"rotation\": "; jsonFloats(out, ob.rotation, 3);
+                out << ", \"scale\": "; jsonFloats(out, ob.scale, 3);
+                out << ",\n        \"hsva\": "; jsonFloats(out, ob.hsva, 4);
+                out << ", \"opacity\": ";
+                jsonFloat(out, ob.opacity);
+                out << ", \"texture\": ";
+                jsonString(out, t.get(ob.texture));
+                out << ",\n        \"size\": "; jsonFloats(out, ob.size, 3);
+                out << ", \"stroke\": ";
+                jsonFloat(out, ob.stroke);
+                out << ", \"filled\": " << (ob.filled ? "true" : "false")
+                    << ", \"loop\": \"" << loopNames[ob.loopType] << "\",\n        \"animations\": [";
+
+                for (std::uint32_t a = ob.firstAnimation; a < ob.firstAnimation + ob.animationCount; ++a) {
+                    const AnimationRecord& an = t.animations[a];
+                    out << (a > ob.firstAnimation ? "," : "") << "\n          { \"index\": " << a
+                        << ", \"parameter\": ";
+                    jsonString(out, ScenesPanel::parameters[an.parameter]);
+                    out << ", \"loop\": \"" << loopNames[an.loopType] << "\", \"easing\": \"" << easingNames[an.easing]
+                        << "\", \"trigger\": " << (an.hasTrigger ? "true" : "false") << ", \"points\": [";
+
+                    for (std::uint32_t p = an.firstPoint; p < an.firstPoint + an.pointCount; ++p) {
+                        const PointRecord& pt = t.points[p];
+                        out << (p > an.firstPoint ? "," : "") << "\n            { \"index\": " << p << ", \"value\": ";
+                        jsonFloats(out, pt.value, 2);
+                        out << ", \"duration\": ";
+                        jsonFloat(out, pt.durationMs);
+                        out << ", \"loop\": \"" << loopNames[pt.loopType]
+                            << "\", \"paths\": [";
+
+                        for (std::uint32_t k = pt.firstPath; k < pt.firstPath + pt.pathCount; ++k) {
+                            const PathRecord& pa = t.paths[k];
+                            out << (k > pt.firstPath ? ", " : "") << "{ \"start\": ";
+                            jsonFloats(out, pa.start, 2);
+                            out << ", \"end\": ";
+                            jsonFloats(out, pa.end, 2);
+                            out << ", \"easing\": \"" << easingNames[pa.easing] << "\", \"endPoint\": ";
+                            if (pa.endPoint == none)
+                                out << "null";
+                            else
+                                out << pa.endPoint;
+                            out << " }";
+                        }
+                        out << "] }";
+                    }
+                    out << " ] }";
+                }
+                out << " ] }";
+            }
+            out << " ] }";
+        }
+
+        out << "\n  ],\n  \"tracks\": [";
+        for (std::size_t i = 0; i < t.tracks.size(); ++i) {
+            const TrackRecord& tr = t.tracks[i];
+            out << (i ? "," : "") << "\n    { \"file\": ";
+            jsonString(out, t.get(tr.filePath));
+            out << ", \"name\": ";
+            jsonString(out, t.get(tr.displayName));
+            out << ", \"start\": ";
+            jsonFloat(out, tr.startTime);
+            out << ", \"color\": ";
+            jsonColor(out, tr.color);
+            out << ", \"muted\": " << (tr.muted ? "true" : "false") << ", \"smoothing\": ";
+            jsonFloat(out, tr.smoothingAlpha);
+            out << ", \"mappings\": [";
+
+            for (std::uint32_t k = tr.firstMapping; k < tr.firstMapping + tr.mappingCount; ++k) {
+                const MappingRecord& m = t.mappings[k];
+                out << (k > tr.firstMapping ? "," : "") << "\n      { \"type\": ";
+                jsonString(out, mapTypeNames[m.type]);
+                out << ", \"audio\": ";
+                jsonString(out, AudioParameterNames[m.audioParameter]);
+                out << ", \"parameter\": ";
+                jsonString(out, ScenesPanel::parameters[m.graphicParameter]);
+                out << ", \"object\": " << m.object;
+                if (static_cast<MapType>(m.type) == MapType::Sync) {
+                    out << ", \"lane\": \"" << (m.laneY ? "y" : "x") << "\", \"input\": ";
+                    jsonFloats(out, m.input, 2);
+                    out << ", \"output\": ";
+                    jsonFloats(out, m.output, 2);
+                }
+                else {
+                    out << ", \"threshold\": ";
+                    jsonFloat(out, m.threshold);
+                    out << ", \"greaterThan\": "
+                        << (m.greaterThan ? "true" : "false") << ", \"animation\": " << m.animation;
+                }
+                out << " }";
+            }
+            out << " ] }";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    bool exportJson(const std::string& path) {
+        const auto projectDir = std::filesystem::absolute(path).parent_path();
+        const Tables t = flatten(projectDir);
+
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            std::cerr << "Could not write " << path << "\n";
+            return false;
+        }
+        writeJson(out, t);
+        return static_cast<bool>(out);
+    }
+
+    // ─── Deferred open from the menu ───
+
+    static std::optional<std::string> pendingLoad;
+
+    void requestLoad(const std::string& path) {
+        pendingLoad = path;
+    }
+
+    bool takeLoadRequest(std::string& path) {
+        if (!pendingLoad)
+            return false;
+        path = *pendingLoad;
+        pendingLoad.reset();
+        return true;
+    }
+}
@@ -0,0 +1,78 @@
+#include "ScenePreloader.h"
+#include "Animation.h"
+#include "AnimationPath.h"
+#include "GeometryCache.h"
+#include "GraphicObject.h"
+#include "Mapping.h"
+#include "Scene.h"
+#include "Timeline.h"
+#include "TimelineIndex.h"
+#include "Trace.h"
+#include <algorithm>
+#include <memory>
+
+namespace {
+    std::weak_ptr<Scene> target;
+    std::size_t nextObject = 0;
+    bool tracksWarmed = false;
+    std::uint64_t animationEpoch = 0;
+    std::uint64_t mappingEpoch = 0;
+
+    void warmObject(GraphicObject& obj) {
+        GeometryCache::vertexArray(obj.getMesh());
+        for (std::size_t parameter = 0; parameter < static_cast<std::size_t>(GraphicParameter::COUNT); ++parameter) {
+            for (auto& animation : obj.getAnimations(parameter))
+                animation->bakedCurve();
+        }
+    }
+
+    // Tracks whose region overlaps the scene are the ones whose mappings run
+    // while it plays
+    void warmTracks(const Scene& scene) {
+        TimelineIndex::tracks().overlapping(scene.startTime / 1000.0f, scene.endTime / 1000.0f,
+            [](const IntervalIndex::Entry& e) {
+                auto& track = Timeline::timelineTracks[e.id];
+                if (track->mappingTable.needsCompile())
+                    track->mappingTable.compile(track->mappings);
+            });
+    }
+}
+
+void ScenePreloader::update(float seconds) {
+    const float ms = seconds * 1000.0f;
+    const int next = TimelineIndex::nextSceneAfter(ms);
+    if (next < 0 || Timeline::scenes[next]->startTime - ms > lookAheadMs)
+        return;
+
+    const auto& scene = Timeline::scenes[next];
+    // Edits made while warming invalidate what was already compiled
+    if (target.lock() != scene || animationEpoch != AnimationEpoch::current || mappingEpoch != MappingEpoch::current) {
+        target = scene;
+        nextObject = 0;
+        tracksWarmed = false;
+        animationEpoch = AnimationEpoch::current;
+        mappingEpoch = MappingEpoch::current;
+        TRACE_DEBUG("Preloading next scene");
+    }
+
+    if (!tracksWarmed) {
+        warmTracks(*scene);
+        tracksWarmed = true;
+    }
+
+    const std::size_t end = (std::min)(scene->objects.size(), nextObject + objectsPerFrame);
+    for (; nextObject < end; ++nextObject)
+        warmObject(*scene->objects[nextObject]);
+}
+
+void ScenePreloader::warm(Scene& scene) {
+    warmTracks(scene);
+    for (auto& obj : scene.objects)
+        warmObject(*obj);
+}
+
+void ScenePreloader::reset() {
+    target.reset();
+    nextObject = 0;
+    tracksWarmed = false;
+}
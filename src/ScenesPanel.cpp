@@ -53,45 +53,6 @@ namespace ScenesPanel {
 
     std::array<ImVec2, 9> minPos = { ImVec2{} };
 
-    // color conversion functions
-    glm::vec4 rgb2hsv(const glm::vec4& c) {
-        float mx = glm::max(glm::max(c.r, c.g), c.b);
-        float mn = glm::min(glm::min(c.r, c.g), c.b);
-        float d = mx - mn;
-        float h = 0.f;
-
-        if (d > 1e-6f) {
-            if (mx == c.r) h = fmod((c.g - c.b) / d, 6.f);
-            else if (mx == c.g) h = (c.b - c.r) / d + 2.f;
-            else                h = (c.r - c.g) / d + 4.f;
-            h /= 6.f;
-            if (h < 0.f) h += 1.f;
-        }
-        float s = (mx < 1e-6f) ? 0.f : d / mx;
-        float v = mx;
-        return { h, s, v, c.w };
-    }
-
-    glm::vec4 hsv2rgb(const glm::vec4& c) {
-        float h = c.x * 6.f;
-        float s = c.y;
-        float v = c.z;
-        int   i = int(floor(h)) % 6;
-        float f = h - floor(h);
-        float p = v * (1.f - s);
-        float q = v * (1.f - s * f);
-        float t = v * (1.f - s * (1.f - f));
-
-        switch (i) {
-        case 0: return { v, t, p, c.w };
-        case 1: return { q, v, p, c.w };
-        case 2: return { p, v, t, c.w };
-        case 3: return { p, q, v, c.w };
-        case 4: return { t, p, v, c.w };
-        default: return { v, p, q, c.w };
-        }
-    }
-
     void renderAddObjectPopup() {
         if (ImGui::BeginPopup("AddObjectPopup")) {
             for (int idx{ 0 }; idx < static_cast<int>(ObjectType::COUNT); ++idx) {
@@ -179,13 +140,14 @@ namespace ScenesPanel {
                     }
 
                     if (ImGui::IsItemClicked()) {
-						std::cout << "Adding mapping for parameter: " << parameters[parameterIndex] << std::endl;
+						TRACE_INFO("Adding mapping for parameter: {}", parameters[parameterIndex].c_str());
                         Canvas::selectedObject->setMapped(parameterIndex, isY);
 
                         AudioParameter ap = AudioParameter(MappingsWindow::audioIndex);
                         GraphicParameter gp = GraphicParameter(parameterIndex);
                         auto newMapping = std::make_shared<SyncMapping>(Canvas::selectedObject, ap, gp, MapType::Sync, isY);
                         TrackFeatures::selectedTrack->mappings[MappingsWindow::audioIndex].push_back(newMapping);
+                        MappingEpoch::bump();
 
                         MappingsWindow::addingMapping = false;
                         mappingIndex = parameterIndex;
@@ -380,7 +342,7 @@ namespace ScenesPanel {
             {
                 activeScene = i;
                 Canvas::clearSelected();
-                GlobalTransport::currentTime = Timeline::scenes[i]->startTime / 1000.0f;
+                GlobalTransport::seek(Timeline::scenes[i]->startTime / 1000.0f);
                 Timeline::currentScene = Timeline::scenes[i];
                 showAnimateWindow = false;
             }
@@ -580,12 +542,12 @@ namespace ScenesPanel {
                         hoverFunc(dl, minPos[4], avail, lh, 4);
                     }
                     // Hue/Saturation
-                    glm::vec4 col = rgb2hsv(obj->getMaterial().color);
+                    glm::vec4 col = obj->getMaterial().hsva;
 
                     minPos[5] = ImGui::GetCursorScreenPos();
 
                     if (ImGui::DragFloat2(parameters[5].c_str(), &col.x, 0.005f, 0.0f, 1.0f, "%.3f"))
-                        obj->setColor(hsv2rgb(col));
+                        obj->setHSVA(col);
 
 					hoverFunc(dl, minPos[5], avail, lh, 5);
                     
@@ -593,7 +555,7 @@ namespace ScenesPanel {
                     minPos[6] = ImGui::GetCursorScreenPos();
 
                     if (ImGui::DragFloat(parameters[6].c_str(), &col.z, 0.005f, 0.0f, 1.0f, "%.3f"))
-                        obj->setColor(hsv2rgb(col));
+                        obj->setHSVA(col);
 
 					hoverFunc(dl, minPos[6], avail, lh, 6);
 
@@ -601,7 +563,7 @@ namespace ScenesPanel {
                     minPos[7] = ImGui::GetCursorScreenPos();
 
                     if (ImGui::DragFloat(parameters[7].c_str(), &col.w, 0.005f, 0.0f, 1.0f, "%.3f"))
-                        obj->setColor(hsv2rgb(col));
+                        obj->setHSVA(col);
 
                     hoverFunc(dl, minPos[7], avail, lh, 7);
 
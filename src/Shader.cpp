@@ -1,5 +1,6 @@
 // Shader.cpp
 #include "Shader.h"
+#include "FrameConstants.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -32,6 +33,10 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
     // 5. Clean up shaders (no longer needed once linked)
     glDeleteShader(vert);
     glDeleteShader(frag);
+
+    // 6. Reflect uniforms and attach shared blocks
+    if (success)
+        reflect();
 }
 
 Shader::~Shader() {
@@ -68,26 +73,86 @@ GLuint Shader::compileShader(const char* src, GLenum type) const {
     return shader;
 }
 
-GLint Shader::getUniformLocation(const char* name) const {
-    GLint loc = glGetUniformLocation(id, name);
-    if (loc == -1) {
+void Shader::reflect() {
+    GLint count = 0, maxLength = 0;
+    glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::string name(std::size_t(maxLength > 0 ? maxLength : 1), '\0');
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(id, GLuint(i), maxLength, &length, &size, &type, name.data());
+        std::string uniformName(name.data(), std::size_t(length));
+
+        // Members of uniform blocks have no location
+        GLint loc = glGetUniformLocation(id, uniformName.c_str());
+        if (loc == -1)
+            continue;
+        locations_[uniformName] = loc;
+
+        // Arrays report "name[0]"; make "name" resolve too
+        auto bracket = uniformName.find('[');
+        if (bracket != std::string::npos)
+            locations_[uniformName.substr(0, bracket)] = loc;
+    }
+
+    GLint blocks = 0;
+    glGetProgramiv(id, GL_ACTIVE_UNIFORM_BLOCKS, &blocks);
+    for (GLint i = 0; i < blocks; ++i) {
+        char blockName[64];
+        glGetActiveUniformBlockName(id, GLuint(i), sizeof(blockName), nullptr, blockName);
+        if (std::string(blockName) == FrameConstants::blockName)
+            glUniformBlockBinding(id, GLuint(i), FrameConstants::binding);
+    }
+}
+
+UniformHandle Shader::uniform(const char* name) const {
+    auto it = locations_.find(name);
+    if (it == locations_.end()) {
         std::cerr << "WARNING::SHADER::UNIFORM_NOT_FOUND: " << name << std::endl;
+        it = locations_.emplace(name, -1).first;
     }
-    return loc;
+    return { it->second };
 }
 
 void Shader::setUniformMat4(const char* name, const glm::mat4& mat) const {
-    glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
+    setUniformMat4(uniform(name), mat);
+}
+
+void Shader::setUniformVec2(const char* name, const glm::vec2& vec) const {
+    setUniformVec2(uniform(name), vec);
 }
 
 void Shader::setUniformVec4(const char* name, const glm::vec4& vec) const {
-    glUniform4fv(getUniformLocation(name), 1, &vec[0]);
+    setUniformVec4(uniform(name), vec);
 }
 
 void Shader::setUniformInt(const char* name, int value) const {
-    glUniform1i(getUniformLocation(name), value);
+    setUniformInt(uniform(name), value);
 }
 
 void Shader::setUniformFloat(const char* name, float value) const {
-    glUniform1f(getUniformLocation(name), value);
+    setUniformFloat(uniform(name), value);
+}
+
+void Shader::setUniformMat4(UniformHandle h, const glm::mat4& mat) const {
+    glUniformMatrix4fv(h.location, 1, GL_FALSE, &mat[0][0]);
+}
+
+void Shader::setUniformVec2(UniformHandle h, const glm::vec2& vec) const {
+    glUniform2fv(h.location, 1, &vec[0]);
+}
+
+void Shader::setUniformVec4(UniformHandle h, const glm::vec4& vec) const {
+    glUniform4fv(h.location, 1, &vec[0]);
+}
+
+void Shader::setUniformInt(UniformHandle h, int value) const {
+    glUniform1i(h.location, value);
+}
+
+void Shader::setUniformFloat(UniformHandle h, float value) const {
+    glUniform1f(h.location, value);
 }
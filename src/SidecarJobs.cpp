@@ -0,0 +1,125 @@
+#include "SidecarJobs.h"
+#include "PcmCache.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+
+bool SidecarSource::prepare() const {
+    std::call_once(once_, [this] {
+        opened_ = audio_.open(path_);
+        if (opened_)
+            hash_ = SidecarJobs::fnv1a(audio_.data(), audio_.size());
+    });
+    return opened_;
+}
+
+SidecarReader::SidecarReader(const SidecarSource& source, std::uint32_t sampleRate,
+    std::uint32_t channels) {
+    if (source.pcm() && source.pcm()->channels() == channels) {
+        pcm_ = source.pcm().get();
+        channels_ = channels;
+        length_ = pcm_->frameCount();
+        return;
+    }
+
+    const MappedFile& audio = source.audio();
+    ma_decoder_config config = ma_decoder_config_init(ma_format_f32, channels, sampleRate);
+    if (ma_decoder_init_memory(audio.data(), audio.size(), &config, &decoder_) != MA_SUCCESS)
+        return;
+    decoderInitialized_ = true;
+    channels_ = decoder_.outputChannels;
+
+    ma_uint64 length = 0;
+    ma_decoder_get_length_in_pcm_frames(&decoder_, &length);
+    length_ = length;
+}
+
+SidecarReader::~SidecarReader() {
+    if (decoderInitialized_)
+        ma_decoder_uninit(&decoder_);
+}
+
+std::uint64_t SidecarReader::read(float* out, std::uint64_t frames) {
+    if (pcm_) {
+        const std::uint64_t n = pcm_->read(position_, out, frames);
+        position_ += n;
+        return n;
+    }
+    if (!decoderInitialized_)
+        return 0;
+
+    ma_uint64 framesRead = 0;
+    ma_decoder_read_pcm_frames(&decoder_, out, frames, &framesRead);
+    return framesRead;
+}
+
+namespace SidecarJobs {
+
+    static std::unique_ptr<ThreadPool> pool;
+    static std::mutex poolMutex;
+    static std::atomic<std::size_t> inFlight{ 0 };
+    static std::atomic<bool> stopping{ false };
+
+    std::uint64_t fnv1a(const std::uint8_t* data, std::size_t size) {
+        std::uint64_t h = 14695981039346656037ull;
+        for (std::size_t i = 0; i < size; ++i) {
+            h ^= data[i];
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    bool write(const std::string& path, const void* header, std::size_t headerBytes,
+        const void* body, std::size_t bodyBytes) {
+        const std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+            if (!out)
+                return false;
+            out.write(static_cast<const char*>(header), static_cast<std::streamsize>(headerBytes));
+            out.write(static_cast<const char*>(body), static_cast<std::streamsize>(bodyBytes));
+            if (!out)
+                return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        if (ec) {
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    void submit(std::function<void()> job, std::function<void()> dropped) {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!pool) {
+            stopping.store(false, std::memory_order_relaxed);
+            pool = std::make_unique<ThreadPool>();
+        }
+
+        inFlight.fetch_add(1, std::memory_order_relaxed);
+        pool->submit([job = std::move(job), dropped = std::move(dropped)] {
+            if (!stopping.load(std::memory_order_relaxed))
+                job();
+            else
+                dropped();
+            inFlight.fetch_sub(1, std::memory_order_relaxed);
+        });
+    }
+
+    bool cancelled() {
+        return stopping.load(std::memory_order_relaxed);
+    }
+
+    std::size_t pending() {
+        return inFlight.load(std::memory_order_relaxed);
+    }
+
+    void shutdown() {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping.store(true, std::memory_order_relaxed);
+        pool.reset();
+    }
+}
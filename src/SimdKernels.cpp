@@ -0,0 +1,420 @@
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define EZVZ_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define EZVZ_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// GCC/Clang only emit AVX2 instructions inside functions that ask for them;
+// MSVC accepts the intrinsics anywhere.
+#if defined(EZVZ_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define EZVZ_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define EZVZ_TARGET_AVX2
+#endif
+
+namespace SimdKernels {
+
+    // ─── Scalar reference ───
+    namespace scalar {
+
+        void deinterleave(const float* in, std::size_t frames, std::size_t channels,
+            std::size_t channel, float* out) {
+            if (channels == 1) {
+                std::memcpy(out, in, frames * sizeof(float));
+                return;
+            }
+            for (std::size_t f = 0; f < frames; ++f)
+                out[f] = in[f * channels + channel];
+        }
+
+        void peakAndSumSquares(const float* x, std::size_t n, float& peak, float& sumSq) {
+            float p = peak;
+            float s = 0.0f;
+            for (std::size_t i = 0; i < n; ++i) {
+                p = (std::max)(p, std::fabs(x[i]));
+                s += x[i] * x[i];
+            }
+            peak = p;
+            sumSq += s;
+        }
+
+        float envelopeFollow(const float* x, std::size_t n, float alpha, float state) {
+            for (std::size_t i = 0; i < n; ++i)
+                state += alpha * (std::fabs(x[i]) - state);
+            return state;
+        }
+
+        std::size_t signChanges(const float* x, std::size_t n, float prev) {
+            std::size_t count = 0;
+            bool wasNeg = prev < 0.0f;
+            for (std::size_t i = 0; i < n; ++i) {
+                bool neg = x[i] < 0.0f;
+                count += (neg != wasNeg);
+                wasNeg = neg;
+            }
+            return count;
+        }
+    }
+
+    // The follower is linear, so over a block of W samples
+    //   y[W] = b^W · y[0] + alpha · Σ b^(W-1-i) · |x[i]|,   b = 1 − alpha.
+    // Each lane accumulates its share of that sum and is decayed by b^W per
+    // block; the lanes are summed once at the end.
+
+#if defined(EZVZ_SIMD_X86)
+    // ─── SSE2 ───
+    namespace sse2 {
+
+        static inline float hsum(__m128 v) {
+            __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+            s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)));
+            return _mm_cvtss_f32(s);
+        }
+
+        static inline float hmax(__m128 v) {
+            __m128 m = _mm_max_ps(v, _mm_movehl_ps(v, v));
+            m = _mm_max_ss(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 1, 1, 1)));
+            return _mm_cvtss_f32(m);
+        }
+
+        static inline std::size_t hsumCount(__m128i v) {
+            alignas(16) std::uint32_t lanes[4];
+            _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+            return std::size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        }
+
+        static void deinterleave(const float* in, std::size_t frames, std::size_t channels,
+            std::size_t channel, float* out) {
+            if (channels != 2) {
+                scalar::deinterleave(in, frames, channels, channel, out);
+                return;
+            }
+            std::size_t f = 0;
+            for (; f + 4 <= frames; f += 4) {
+                __m128 a = _mm_loadu_ps(in + 2 * f);
+                __m128 b = _mm_loadu_ps(in + 2 * f + 4);
+                __m128 r = channel == 0
+                    ? _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))
+                    : _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                _mm_storeu_ps(out + f, r);
+            }
+            for (; f < frames; ++f)
+                out[f] = in[2 * f + channel];
+        }
+
+        static void peakAndSumSquares(const float* x, std::size_t n, float& peak, float& sumSq) {
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            __m128 vp = _mm_set1_ps(peak);
+            __m128 vs = _mm_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m128 v = _mm_loadu_ps(x + i);
+                vp = _mm_max_ps(vp, _mm_and_ps(v, absMask));
+                vs = _mm_add_ps(vs, _mm_mul_ps(v, v));
+            }
+            float p = hmax(vp);
+            float s = hsum(vs);
+            for (; i < n; ++i) {
+                p = (std::max)(p, std::fabs(x[i]));
+                s += x[i] * x[i];
+            }
+            peak = p;
+            sumSq += s;
+        }
+
+        static float envelopeFollow(const float* x, std::size_t n, float alpha, float state) {
+            const float b = 1.0f - alpha;
+            const float b2 = b * b, b3 = b2 * b, b4 = b2 * b2;
+            const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+            const __m128 coef = _mm_set_ps(1.0f, b, b2, b3);   // lane j weighs b^(3-j)
+            const __m128 decay4 = _mm_set1_ps(b4);
+
+            __m128 acc = _mm_setzero_ps();
+            float decay = 1.0f;
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m128 v = _mm_and_ps(_mm_loadu_ps(x + i), absMask);
+                acc = _mm_add_ps(_mm_mul_ps(acc, decay4), _mm_mul_ps(coef, v));
+                decay *= b4;
+            }
+            state = state * decay + alpha * hsum(acc);
+            return scalar::envelopeFollow(x + i, n - i, alpha, state);
+        }
+
+        static std::size_t signChanges(const float* x, std::size_t n, float prev) {
+            if (n == 0)
+                return 0;
+            std::size_t count = (x[0] < 0.0f) != (prev < 0.0f);
+            const __m128 zero = _mm_setzero_ps();
+            __m128i cnt = _mm_setzero_si128();
+            std::size_t i = 1;
+            for (; i + 4 <= n; i += 4) {
+                __m128 cur = _mm_cmplt_ps(_mm_loadu_ps(x + i), zero);
+                __m128 prv = _mm_cmplt_ps(_mm_loadu_ps(x + i - 1), zero);
+                // a flipped lane is all ones (−1), so subtracting counts it
+                cnt = _mm_sub_epi32(cnt, _mm_castps_si128(_mm_xor_ps(cur, prv)));
+            }
+            count += hsumCount(cnt);
+            return count + scalar::signChanges(x + i, n - i, x[i - 1]);
+        }
+    }
+
+    // ─── AVX2 ───
+    namespace avx2 {
+
+        EZVZ_TARGET_AVX2 static inline float hsum(__m256 v) {
+            __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            return sse2::hsum(s);
+        }
+
+        EZVZ_TARGET_AVX2 static inline float hmax(__m256 v) {
+            __m128 m = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+            return sse2::hmax(m);
+        }
+
+        EZVZ_TARGET_AVX2 static void deinterleave(const float* in, std::size_t frames,
+            std::size_t channels, std::size_t channel, float* out) {
+            if (channels != 2) {
+                scalar::deinterleave(in, frames, channels, channel, out);
+                return;
+            }
+            std::size_t f = 0;
+            for (; f + 8 <= frames; f += 8) {
+                __m256 a = _mm256_loadu_ps(in + 2 * f);
+                __m256 b = _mm256_loadu_ps(in + 2 * f + 8);
+                // per 128-bit lane: a0 a2 b0 b2 | a4 a6 b4 b6, then fix the 64-bit order
+                __m256 s = channel == 0
+                    ? _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0))
+                    : _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                __m256 r = _mm256_castpd_ps(
+                    _mm256_permute4x64_pd(_mm256_castps_pd(s), _MM_SHUFFLE(3, 1, 2, 0)));
+                _mm256_storeu_ps(out + f, r);
+            }
+            for (; f < frames; ++f)
+                out[f] = in[2 * f + channel];
+        }
+
+        EZVZ_TARGET_AVX2 static void peakAndSumSquares(const float* x, std::size_t n,
+            float& peak, float& sumSq) {
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+            __m256 vp = _mm256_set1_ps(peak);
+            __m256 vs = _mm256_setzero_ps();
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256 v = _mm256_loadu_ps(x + i);
+                vp = _mm256_max_ps(vp, _mm256_and_ps(v, absMask));
+                vs = _mm256_add_ps(vs, _mm256_mul_ps(v, v));
+            }
+            float p = hmax(vp);
+            float s = hsum(vs);
+            for (; i < n; ++i) {
+                p = (std::max)(p, std::fabs(x[i]));
+                s += x[i] * x[i];
+            }
+            peak = p;
+            sumSq += s;
+        }
+
+        EZVZ_TARGET_AVX2 static float envelopeFollow(const float* x, std::size_t n,
+            float alpha, float state) {
+            float pw[8];
+            const float b = 1.0f - alpha;
+            pw[7] = 1.0f;
+            for (int k = 6; k >= 0; --k) pw[k] = pw[k + 1] * b;   // pw[j] = b^(7-j)
+            const float b8 = pw[0] * b;
+
+            const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+            const __m256 coef = _mm256_loadu_ps(pw);
+            const __m256 decay8 = _mm256_set1_ps(b8);
+
+            __m256 acc = _mm256_setzero_ps();
+            float decay = 1.0f;
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256 v = _mm256_and_ps(_mm256_loadu_ps(x + i), absMask);
+                acc = _mm256_add_ps(_mm256_mul_ps(acc, decay8), _mm256_mul_ps(coef, v));
+                decay *= b8;
+            }
+            state = state * decay + alpha * hsum(acc);
+            return scalar::envelopeFollow(x + i, n - i, alpha, state);
+        }
+
+        EZVZ_TARGET_AVX2 static std::size_t signChanges(const float* x, std::size_t n, float prev) {
+            if (n == 0)
+                return 0;
+            std::size_t count = (x[0] < 0.0f) != (prev < 0.0f);
+            const __m256 zero = _mm256_setzero_ps();
+            __m256i cnt = _mm256_setzero_si256();
+            std::size_t i = 1;
+            for (; i + 8 <= n; i += 8) {
+                __m256 cur = _mm256_cmp_ps(_mm256_loadu_ps(x + i), zero, _CMP_LT_OQ);
+                __m256 prv = _mm256_cmp_ps(_mm256_loadu_ps(x + i - 1), zero, _CMP_LT_OQ);
+                cnt = _mm256_sub_epi32(cnt, _mm256_castps_si256(_mm256_xor_ps(cur, prv)));
+            }
+            __m128i c = _mm_add_epi32(_mm256_castsi256_si128(cnt), _mm256_extracti128_si256(cnt, 1));
+            count += sse2::hsumCount(c);
+            return count + scalar::signChanges(x + i, n - i, x[i - 1]);
+        }
+    }
+
+    static bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7)
+            return false;
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)   // OS saves YMM state
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+#endif // EZVZ_SIMD_X86
+
+#if defined(EZVZ_SIMD_NEON)
+    // ─── NEON (always present on AArch64) ───
+    namespace neon {
+
+        static void deinterleave(const float* in, std::size_t frames, std::size_t channels,
+            std::size_t channel, float* out) {
+            if (channels != 2) {
+                scalar::deinterleave(in, frames, channels, channel, out);
+                return;
+            }
+            std::size_t f = 0;
+            for (; f + 4 <= frames; f += 4) {
+                float32x4x2_t v = vld2q_f32(in + 2 * f);
+                vst1q_f32(out + f, channel == 0 ? v.val[0] : v.val[1]);
+            }
+            for (; f < frames; ++f)
+                out[f] = in[2 * f + channel];
+        }
+
+        static void peakAndSumSquares(const float* x, std::size_t n, float& peak, float& sumSq) {
+            float32x4_t vp = vdupq_n_f32(peak);
+            float32x4_t vs = vdupq_n_f32(0.0f);
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                float32x4_t v = vld1q_f32(x + i);
+                vp = vmaxq_f32(vp, vabsq_f32(v));
+                vs = vmlaq_f32(vs, v, v);
+            }
+            float p = vmaxvq_f32(vp);
+            float s = vaddvq_f32(vs);
+            for (; i < n; ++i) {
+                p = (std::max)(p, std::fabs(x[i]));
+                s += x[i] * x[i];
+            }
+            peak = p;
+            sumSq += s;
+        }
+
+        static float envelopeFollow(const float* x, std::size_t n, float alpha, float state) {
+            const float b = 1.0f - alpha;
+            const float b2 = b * b, b3 = b2 * b, b4 = b2 * b2;
+            const float pw[4] = { b3, b2, b, 1.0f };
+            const float32x4_t coef = vld1q_f32(pw);
+
+            float32x4_t acc = vdupq_n_f32(0.0f);
+            float decay = 1.0f;
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                float32x4_t v = vabsq_f32(vld1q_f32(x + i));
+                acc = vmlaq_f32(vmulq_n_f32(acc, b4), coef, v);
+                decay *= b4;
+            }
+            state = state * decay + alpha * vaddvq_f32(acc);
+            return scalar::envelopeFollow(x + i, n - i, alpha, state);
+        }
+
+        static std::size_t signChanges(const float* x, std::size_t n, float prev) {
+            if (n == 0)
+                return 0;
+            std::size_t count = (x[0] < 0.0f) != (prev < 0.0f);
+            const float32x4_t zero = vdupq_n_f32(0.0f);
+            uint32x4_t cnt = vdupq_n_u32(0);
+            std::size_t i = 1;
+            for (; i + 4 <= n; i += 4) {
+                uint32x4_t cur = vcltq_f32(vld1q_f32(x + i), zero);
+                uint32x4_t prv = vcltq_f32(vld1q_f32(x + i - 1), zero);
+                cnt = vsubq_u32(cnt, veorq_u32(cur, prv));
+            }
+            count += vaddvq_u32(cnt);
+            return count + scalar::signChanges(x + i, n - i, x[i - 1]);
+        }
+    }
+#endif // EZVZ_SIMD_NEON
+
+    // ─── Dispatch ───
+    struct KernelTable {
+        Isa isa;
+        void (*deinterleave)(const float*, std::size_t, std::size_t, std::size_t, float*);
+        void (*peakAndSumSquares)(const float*, std::size_t, float&, float&);
+        float (*envelopeFollow)(const float*, std::size_t, float, float);
+        std::size_t (*signChanges)(const float*, std::size_t, float);
+    };
+
+    static KernelTable selectKernels() {
+#if defined(EZVZ_SIMD_X86)
+        if (cpuHasAvx2())
+            return { Isa::AVX2, avx2::deinterleave, avx2::peakAndSumSquares,
+                     avx2::envelopeFollow, avx2::signChanges };
+        return { Isa::SSE2, sse2::deinterleave, sse2::peakAndSumSquares,
+                 sse2::envelopeFollow, sse2::signChanges };
+#elif defined(EZVZ_SIMD_NEON)
+        return { Isa::NEON, neon::deinterleave, neon::peakAndSumSquares,
+                 neon::envelopeFollow, neon::signChanges };
+#else
+        return { Isa::Scalar, scalar::deinterleave, scalar::peakAndSumSquares,
+                 scalar::envelopeFollow, scalar::signChanges };
+#endif
+    }
+
+    // Resolved during static initialisation, before any audio thread exists
+    static const KernelTable kernels = selectKernels();
+
+    Isa activeIsa() { return kernels.isa; }
+
+    const char* isaName(Isa isa) {
+        switch (isa) {
+        case Isa::SSE2: return "SSE2";
+        case Isa::AVX2: return "AVX2";
+        case Isa::NEON: return "NEON";
+        default:        return "Scalar";
+        }
+    }
+
+    void deinterleave(const float* in, std::size_t frames, std::size_t channels,
+        std::size_t channel, float* out) {
+        kernels.deinterleave(in, frames, channels, channel, out);
+    }
+
+    void peakAndSumSquares(const float* x, std::size_t n, float& peak, float& sumSq) {
+        kernels.peakAndSumSquares(x, n, peak, sumSq);
+    }
+
+    float envelopeFollow(const float* x, std::size_t n, float alpha, float state) {
+        return kernels.envelopeFollow(x, n, alpha, state);
+    }
+
+    std::size_t signChanges(const float* x, std::size_t n, float prev) {
+        return kernels.signChanges(x, n, prev);
+    }
+}
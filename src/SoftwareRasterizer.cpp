@@ -0,0 +1,373 @@
+#include "SoftwareRasterizer.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define EZVZ_SIMD_X86 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define EZVZ_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+    constexpr int tileSize = 64;
+    constexpr int sampleCount = 4;
+    constexpr float subpixelSteps = 256.0f;   // vertices snap to 1/256 px, as GL rasterisers do
+
+    // Standard 4x pattern, offsets from the pixel's lower-left corner
+    constexpr float sampleX[sampleCount] = { 0.375f, 0.875f, 0.125f, 0.625f };
+    constexpr float sampleY[sampleCount] = { 0.125f, 0.375f, 0.625f, 0.875f };
+
+    glm::vec2 safeNormalize(glm::vec2 v) {
+        float len = glm::length(v);
+        return len > 0.0f ? v / len : glm::vec2(0.0f);
+    }
+
+    glm::vec2 perp(glm::vec2 v) {
+        return { -v.y, v.x };
+    }
+
+    glm::vec2 sign(glm::vec2 v) {
+        return { float((v.x > 0.0f) - (v.x < 0.0f)), float((v.y > 0.0f) - (v.y < 0.0f)) };
+    }
+
+    // Same as hsv2rgb in vertex.glsl; hue wraps
+    glm::vec3 hsv2rgb(glm::vec3 c) {
+        glm::vec3 k;
+        const float shift[3] = { 0.0f, 4.0f, 2.0f };
+        for (int i = 0; i < 3; ++i) {
+            float m = c.x * 6.0f + shift[i];
+            m -= 6.0f * std::floor(m / 6.0f);
+            k[i] = std::clamp(std::abs(m - 3.0f) - 1.0f, 0.0f, 1.0f);
+        }
+        return c.z * glm::mix(glm::vec3(1.0f), k, c.y);
+    }
+
+    // Object-space position of one unit-mesh vertex, as vertex.glsl computes it
+    glm::vec2 meshPosition(const MeshVertex& v, glm::vec2 size, float stroke) {
+        glm::vec2 base = v.pos * size;
+        glm::vec2 s = sign(base);
+        glm::vec2 p = s * glm::max(s * (base + v.offset * stroke), glm::vec2(0.0f));
+
+        if (v.miter != 0.0f) {
+            glm::vec2 n = perp(safeNormalize(base - v.prev * size))
+                        + perp(safeNormalize(v.next * size - base));
+            p += safeNormalize(n) * v.miter * stroke;
+        }
+        return p;
+    }
+
+    float snap(float v) {
+        return std::round(v * subpixelSteps) / subpixelSteps;
+    }
+
+    std::uint8_t toUnorm8(float v) {
+        return std::uint8_t(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+struct SoftwareRasterizer::Triangle {
+    // Edge i is A·x + B·y + C, positive inside; the offsets add each sample's
+    // position so one pixel's four samples are a single vector operation
+    alignas(16) float edgeOffset[3][sampleCount];
+    alignas(16) float depthOffset[sampleCount];
+    float A[3], B[3], C[3];
+    bool topLeft[3];
+    float dzdx, dzdy, z0;
+    float color[4];
+    int minX, minY, maxX, maxY;   // inclusive pixel bounds, clipped to the target
+};
+
+namespace {
+    using Triangle = SoftwareRasterizer::Triangle;
+
+    // Coverage of the four samples of pixel (px, py) as a bit mask, and their depths.
+    // A sample exactly on an edge belongs to it only if the edge is top or left.
+#if defined(EZVZ_SIMD_X86)
+    int coverage(const Triangle& t, float px, float py, float* depth) {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        const __m128 zero = _mm_setzero_ps();
+        for (int e = 0; e < 3; ++e) {
+            __m128 v = _mm_add_ps(_mm_set1_ps(t.A[e] * px + t.B[e] * py + t.C[e]),
+                _mm_load_ps(t.edgeOffset[e]));
+            inside = _mm_and_ps(inside, t.topLeft[e] ? _mm_cmpge_ps(v, zero) : _mm_cmpgt_ps(v, zero));
+        }
+        int mask = _mm_movemask_ps(inside);
+        if (mask)
+            _mm_storeu_ps(depth, _mm_add_ps(_mm_set1_ps(t.dzdx * px + t.dzdy * py + t.z0),
+                _mm_load_ps(t.depthOffset)));
+        return mask;
+    }
+#elif defined(EZVZ_SIMD_NEON)
+    int coverage(const Triangle& t, float px, float py, float* depth) {
+        uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        for (int e = 0; e < 3; ++e) {
+            float32x4_t v = vaddq_f32(vdupq_n_f32(t.A[e] * px + t.B[e] * py + t.C[e]),
+                vld1q_f32(t.edgeOffset[e]));
+            inside = vandq_u32(inside, t.topLeft[e] ? vcgeq_f32(v, zero) : vcgtq_f32(v, zero));
+        }
+        const uint32x4_t bits = { 1, 2, 4, 8 };
+        int mask = int(vaddvq_u32(vandq_u32(inside, bits)));
+        if (mask)
+            vst1q_f32(depth, vaddq_f32(vdupq_n_f32(t.dzdx * px + t.dzdy * py + t.z0),
+                vld1q_f32(t.depthOffset)));
+        return mask;
+    }
+#else
+    int coverage(const Triangle& t, float px, float py, float* depth) {
+        int mask = 0xF;
+        for (int e = 0; e < 3; ++e) {
+            float base = t.A[e] * px + t.B[e] * py + t.C[e];
+            for (int k = 0; k < sampleCount; ++k) {
+                float v = base + t.edgeOffset[e][k];
+                if (!(t.topLeft[e] ? v >= 0.0f : v > 0.0f))
+                    mask &= ~(1 << k);
+            }
+        }
+        if (mask) {
+            float base = t.dzdx * px + t.dzdy * py + t.z0;
+            for (int k = 0; k < sampleCount; ++k)
+                depth[k] = base + t.depthOffset[k];
+        }
+        return mask;
+    }
+#endif
+}
+
+SoftwareRasterizer::SoftwareRasterizer(unsigned int threads)
+    : pool_(std::make_unique<WorkStealingPool>(threads)) {
+}
+
+SoftwareRasterizer::~SoftwareRasterizer() = default;
+
+void SoftwareRasterizer::beginFrame(int width, int height, const glm::vec4& clearColor,
+    const glm::mat4& view, const glm::mat4& projection) {
+    if (width != width_ || height != height_) {
+        width_ = width;
+        height_ = height;
+        tilesX_ = (width + tileSize - 1) / tileSize;
+        tilesY_ = (height + tileSize - 1) / tileSize;
+        samples_.resize(std::size_t(width) * height * sampleCount * 4);
+        depth_.resize(std::size_t(width) * height * sampleCount);
+        resolved_.resize(std::size_t(width) * height * 4);
+        bins_.assign(std::size_t(tilesX_) * tilesY_, {});
+    }
+    viewProjection_ = projection * view;
+
+    const std::uint8_t clear[4] = { toUnorm8(clearColor.r), toUnorm8(clearColor.g),
+        toUnorm8(clearColor.b), toUnorm8(clearColor.a) };
+    pool_->run(std::size_t(tilesY_), [&](std::size_t band) {
+        auto [first, last] = bandSamples(band);
+        for (std::size_t i = first; i < last; ++i)
+            std::memcpy(&samples_[i * 4], clear, 4);
+        std::fill(depth_.begin() + first, depth_.begin() + last, 1.0f);
+    });
+}
+
+// Sample range [first, last) of one row of tiles
+std::pair<std::size_t, std::size_t> SoftwareRasterizer::bandSamples(std::size_t band) const {
+    std::size_t rowSamples = std::size_t(width_) * sampleCount;
+    std::size_t y0 = band * tileSize;
+    std::size_t y1 = (std::min)(y0 + tileSize, std::size_t(height_));
+    return { y0 * rowSamples, y1 * rowSamples };
+}
+
+void SoftwareRasterizer::submit(const UnitMesh& mesh, bool filled, float lineWidth, const InstanceData& instance) {
+    pending_.push_back({ &mesh, filled, lineWidth, instance });
+}
+
+void SoftwareRasterizer::addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+    const glm::vec4& color) {
+    glm::vec3 v[3] = { a, b, c };
+    for (auto& p : v) {
+        p.x = snap(p.x);
+        p.y = snap(p.y);
+    }
+
+    // No face culling, so bring both windings to counter-clockwise
+    float area = (v[1].x - v[0].x) * (v[2].y - v[0].y) - (v[2].x - v[0].x) * (v[1].y - v[0].y);
+    if (area == 0.0f)
+        return;
+    if (area < 0.0f) {
+        std::swap(v[1], v[2]);
+        area = -area;
+    }
+
+    Triangle t;
+    t.minX = (std::max)(0, int(std::floor((std::min)({ v[0].x, v[1].x, v[2].x }))));
+    t.minY = (std::max)(0, int(std::floor((std::min)({ v[0].y, v[1].y, v[2].y }))));
+    t.maxX = (std::min)(width_ - 1, int(std::floor((std::max)({ v[0].x, v[1].x, v[2].x }))));
+    t.maxY = (std::min)(height_ - 1, int(std::floor((std::max)({ v[0].y, v[1].y, v[2].y }))));
+    if (t.minX > t.maxX || t.minY > t.maxY)
+        return;
+
+    for (int e = 0; e < 3; ++e) {
+        const glm::vec3& p0 = v[e];
+        const glm::vec3& p1 = v[(e + 1) % 3];
+        t.A[e] = p0.y - p1.y;
+        t.B[e] = p1.x - p0.x;
+        t.C[e] = -(t.A[e] * p0.x + t.B[e] * p0.y);
+        t.topLeft[e] = t.A[e] > 0.0f || (t.A[e] == 0.0f && t.B[e] < 0.0f);
+        for (int k = 0; k < sampleCount; ++k)
+            t.edgeOffset[e][k] = t.A[e] * sampleX[k] + t.B[e] * sampleY[k];
+    }
+
+    // Window-space depth is linear in x and y
+    t.dzdx = ((v[1].z - v[0].z) * (v[2].y - v[0].y) - (v[2].z - v[0].z) * (v[1].y - v[0].y)) / area;
+    t.dzdy = ((v[1].x - v[0].x) * (v[2].z - v[0].z) - (v[2].x - v[0].x) * (v[1].z - v[0].z)) / area;
+    t.z0 = v[0].z - t.dzdx * v[0].x - t.dzdy * v[0].y;
+    for (int k = 0; k < sampleCount; ++k)
+        t.depthOffset[k] = t.dzdx * sampleX[k] + t.dzdy * sampleY[k];
+
+    for (int i = 0; i < 4; ++i)
+        t.color[i] = std::clamp(color[i], 0.0f, 1.0f);
+
+    const std::uint32_t index = std::uint32_t(triangles_.size());
+    triangles_.push_back(t);
+    for (int ty = t.minY / tileSize; ty <= t.maxY / tileSize; ++ty)
+        for (int tx = t.minX / tileSize; tx <= t.maxX / tileSize; ++tx)
+            bins_[std::size_t(ty) * tilesX_ + tx].push_back(index);
+}
+
+// Multisampled GL lines cover a width-wide rectangle along the segment
+void SoftwareRasterizer::addLine(const glm::vec3& a, const glm::vec3& b, float width, const glm::vec4& color) {
+    glm::vec2 dir = safeNormalize(glm::vec2(b) - glm::vec2(a));
+    if (dir == glm::vec2(0.0f))
+        return;
+    glm::vec3 n(perp(dir) * (width * 0.5f), 0.0f);
+    addTriangle(a + n, b + n, b - n, color);
+    addTriangle(a + n, b - n, a - n, color);
+}
+
+void SoftwareRasterizer::addSubmission(const Submission& s, bool wireframe) {
+    const UnitMesh& mesh = *s.mesh;
+    const InstanceData& inst = s.instance;
+    const MeshRange& range = s.filled ? mesh.fill : mesh.stroke;
+    const glm::mat4 mvp = viewProjection_ * inst.model;
+    const glm::vec4 color(hsv2rgb(glm::vec3(inst.hsva)), inst.hsva.w);
+
+    // Vertex stage, once per mesh vertex; w <= 0 marks it unusable
+    std::vector<glm::vec4>& window = window_;
+    window.resize(mesh.vertices.size());
+    for (std::size_t i = 0; i < mesh.vertices.size(); ++i) {
+        glm::vec4 clip = mvp * glm::vec4(meshPosition(mesh.vertices[i], inst.size, inst.stroke), 0.0f, 1.0f);
+        if (clip.w <= 1e-6f) {
+            window[i] = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+            continue;
+        }
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        window[i] = glm::vec4((ndc.x * 0.5f + 0.5f) * width_, (ndc.y * 0.5f + 0.5f) * height_,
+            ndc.z * 0.5f + 0.5f, 1.0f);
+    }
+
+    auto at = [&](GLsizei i) { return mesh.indices[std::size_t(range.first + i)]; };
+    auto usable = [&](std::uint32_t i) { return window[i].w > 0.0f; };
+
+    if (mesh.primitive == GL_LINES) {
+        for (GLsizei i = 0; i + 1 < range.count; i += 2) {
+            std::uint32_t a = at(i), b = at(i + 1);
+            if (usable(a) && usable(b))
+                addLine(glm::vec3(window[a]), glm::vec3(window[b]), s.lineWidth, color);
+        }
+        return;
+    }
+
+    for (GLsizei i = 0; i + 2 < range.count; i += 3) {
+        std::uint32_t a = at(i), b = at(i + 1), c = at(i + 2);
+        if (!usable(a) || !usable(b) || !usable(c))
+            continue;
+        if (wireframe) {
+            glm::vec3 pa(window[a]), pb(window[b]), pc(window[c]);
+            addLine(pa, pb, s.lineWidth, color);
+            addLine(pb, pc, s.lineWidth, color);
+            addLine(pc, pa, s.lineWidth, color);
+        }
+        else {
+            addTriangle(glm::vec3(window[a]), glm::vec3(window[b]), glm::vec3(window[c]), color);
+        }
+    }
+}
+
+void SoftwareRasterizer::rasterizeTile(std::size_t tile, const PassState& state) {
+    const int x0 = int(tile % tilesX_) * tileSize;
+    const int y0 = int(tile / tilesX_) * tileSize;
+    const int x1 = (std::min)(x0 + tileSize, width_) - 1;
+    const int y1 = (std::min)(y0 + tileSize, height_) - 1;
+
+    alignas(16) float depth[sampleCount];
+    for (std::uint32_t index : bins_[tile]) {
+        const Triangle& t = triangles_[index];
+        const float alpha = t.color[3];
+
+        for (int py = (std::max)(y0, t.minY); py <= (std::min)(y1, t.maxY); ++py) {
+            for (int px = (std::max)(x0, t.minX); px <= (std::min)(x1, t.maxX); ++px) {
+                int mask = coverage(t, float(px), float(py), depth);
+                if (!mask)
+                    continue;
+
+                const std::size_t base = (std::size_t(py) * width_ + px) * sampleCount;
+                for (int k = 0; k < sampleCount; ++k) {
+                    if (!(mask & (1 << k)))
+                        continue;
+                    float z = depth[k];
+                    if (z < 0.0f || z > 1.0f)
+                        continue;   // outside the near/far planes
+
+                    float& stored = depth_[base + k];
+                    if (state.depthTest) {
+                        if (!(z < stored))
+                            continue;
+                        if (state.depthWrite)
+                            stored = z;
+                    }
+
+                    // SRC_ALPHA, ONE_MINUS_SRC_ALPHA on all four channels
+                    std::uint8_t* dst = &samples_[(base + k) * 4];
+                    for (int c = 0; c < 4; ++c)
+                        dst[c] = std::uint8_t(std::clamp(
+                            t.color[c] * alpha * 255.0f + dst[c] * (1.0f - alpha) + 0.5f, 0.0f, 255.0f));
+                }
+            }
+        }
+    }
+}
+
+void SoftwareRasterizer::flush(const PassState& state) {
+    if (pending_.empty())
+        return;
+
+    // Submission order is draw order; with depth testing it only matters for ties,
+    // and blended passes rely on it, so preserveOrder needs nothing extra here
+    triangles_.clear();
+    for (auto& bin : bins_)
+        bin.clear();
+    for (const Submission& s : pending_)
+        addSubmission(s, state.wireframe);
+    pending_.clear();
+
+    activeTiles_.clear();
+    for (std::size_t i = 0; i < bins_.size(); ++i) {
+        if (!bins_[i].empty())
+            activeTiles_.push_back(std::uint32_t(i));
+    }
+
+    pool_->run(activeTiles_.size(), [&](std::size_t i) {
+        rasterizeTile(activeTiles_[i], state);
+    });
+}
+
+void SoftwareRasterizer::endFrame() {
+    // Box-filter resolve of the four samples, like glBlitFramebuffer from the MSAA FBO
+    pool_->run(std::size_t(tilesY_), [&](std::size_t band) {
+        auto [first, last] = bandSamples(band);
+        for (std::size_t p = first / sampleCount; p < last / sampleCount; ++p) {
+            const std::uint8_t* s = &samples_[p * sampleCount * 4];
+            for (int c = 0; c < 4; ++c)
+                resolved_[p * 4 + c] = std::uint8_t((s[c] + s[4 + c] + s[8 + c] + s[12 + c] + 2) / 4);
+        }
+    });
+}
@@ -0,0 +1,161 @@
+#include "SpectralAnalyzer.h"
+#include <algorithm>
+#include <cmath>
+
+static constexpr float kEps = 1e-12f;
+static constexpr float kRolloffFraction = 0.85f;
+static constexpr float kContrastRangeDb = 60.0f;   // contrast is reported as dB / 60
+
+SpectralAnalyzer::SpectralAnalyzer(std::size_t fftSize, std::size_t hop)
+    : fft_(fftSize)
+    , hop_(std::max<std::size_t>(1, hop))
+{
+    const std::size_t n = fft_.size();
+    const std::size_t bins = fft_.bins();
+
+    window_.resize(n);
+    for (std::size_t i = 0; i < n; ++i)
+        window_[i] = 0.5f - 0.5f * std::cos(6.28318530718f * float(i) / float(n));
+
+    history_.assign(n, 0.0f);
+    frame_.assign(n, 0.0f);
+    re_.assign(bins, 0.0f);
+    im_.assign(bins, 0.0f);
+    mag_.assign(bins, 0.0f);
+    prevMag_.assign(bins, 0.0f);
+
+    for (auto& f : features_)
+        f.store(0.0f, std::memory_order_relaxed);
+}
+
+void SpectralAnalyzer::push(const float* samples, std::size_t numSamples, std::size_t stride)
+{
+    const std::size_t n = history_.size();
+    float out[static_cast<std::size_t>(SpectralFeature::COUNT)];
+
+    for (std::size_t i = 0; i < numSamples; ++i) {
+        history_[writePos_] = samples[i * stride];
+        writePos_ = (writePos_ + 1) & (n - 1);
+
+        if (++sinceHop_ < hop_)
+            continue;
+        sinceHop_ = 0;
+
+        // unwrap the circular history, oldest sample first
+        std::size_t tail = n - writePos_;
+        std::copy(history_.begin() + writePos_, history_.end(), frame_.begin());
+        std::copy(history_.begin(), history_.begin() + writePos_, frame_.begin() + tail);
+
+        analyzeFrame(frame_.data(), out);
+
+        for (std::size_t f = 0; f < features_.size(); ++f)
+            features_[f].store(out[f], std::memory_order_relaxed);
+    }
+}
+
+void SpectralAnalyzer::analyzeFrame(const float* frame, float* out)
+{
+    const std::size_t n = fft_.size();
+    const std::size_t bins = fft_.bins();
+
+    for (std::size_t i = 0; i < n; ++i)
+        frame_[i] = frame[i] * window_[i];
+
+    fft_.forward(frame_.data(), re_.data(), im_.data());
+
+    // ─── one shared magnitude spectrum ───
+    const float norm = 4.0f / float(n);   // 2/N for one-sided, ×2 for the Hann gain
+    float sumM = 0.0f, sumP = 0.0f, sumFM = 0.0f, sumLogP = 0.0f, flux = 0.0f;
+    const float binToFreq = 1.0f / float(bins - 1);   // bin → fraction of Nyquist
+
+    for (std::size_t k = 0; k < bins; ++k) {
+        float m = std::sqrt(re_[k] * re_[k] + im_[k] * im_[k]) * norm;
+        mag_[k] = m;
+        float p = m * m;
+        sumM += m;
+        sumP += p;
+        sumFM += float(k) * binToFreq * m;
+        sumLogP += std::log(p + kEps);
+        float d = m - prevMag_[k];
+        if (d > 0.0f) flux += d;
+    }
+
+    float* result = out;
+    std::fill(result, result + static_cast<std::size_t>(SpectralFeature::COUNT), 0.0f);
+
+    if (sumM <= kEps) {
+        std::swap(mag_, prevMag_);
+        return;
+    }
+
+    // ─── centroid and central moments (frequencies in fractions of Nyquist) ───
+    const float centroid = sumFM / sumM;
+    float m2 = 0.0f, m3 = 0.0f, m4 = 0.0f;
+    for (std::size_t k = 0; k < bins; ++k) {
+        float d = float(k) * binToFreq - centroid;
+        float d2 = d * d;
+        m2 += d2 * mag_[k];
+        m3 += d2 * d * mag_[k];
+        m4 += d2 * d2 * mag_[k];
+    }
+    m2 /= sumM; m3 /= sumM; m4 /= sumM;
+    const float sigma = std::sqrt(m2);
+
+    // ─── rolloff ───
+    float rolloff = 1.0f;
+    float cumulative = 0.0f;
+    const float threshold = kRolloffFraction * sumP;
+    for (std::size_t k = 0; k < bins; ++k) {
+        cumulative += mag_[k] * mag_[k];
+        if (cumulative >= threshold) {
+            rolloff = float(k) * binToFreq;
+            break;
+        }
+    }
+
+    // ─── flatness (geometric / arithmetic mean of power) ───
+    const float meanP = sumP / float(bins);
+    const float flatness = std::exp(sumLogP / float(bins)) / (meanP + kEps);
+
+    // ─── entropy of the normalised power distribution ───
+    float entropy = 0.0f;
+    for (std::size_t k = 0; k < bins; ++k) {
+        float q = (mag_[k] * mag_[k]) / sumP;
+        if (q > kEps) entropy -= q * std::log(q);
+    }
+    entropy /= std::log(float(bins));
+
+    // ─── contrast: peak vs valley per octave band, averaged ───
+    float contrastDb = 0.0f;
+    int bands = 0;
+    for (std::size_t lo = 1; lo < bins; lo <<= 1) {
+        std::size_t hi = (std::min)(lo << 1, bins);
+        float bandMean = 0.0f;
+        for (std::size_t k = lo; k < hi; ++k) bandMean += mag_[k];
+        bandMean /= float(hi - lo);
+
+        float peak = 0.0f, valley = 0.0f;
+        int peaks = 0, valleys = 0;
+        for (std::size_t k = lo; k < hi; ++k) {
+            if (mag_[k] > bandMean) { peak += mag_[k]; ++peaks; }
+            else { valley += mag_[k]; ++valleys; }
+        }
+        peak = peaks ? peak / float(peaks) : bandMean;
+        valley = valleys ? valley / float(valleys) : bandMean;
+        contrastDb += 20.0f * std::log10((peak + kEps) / (valley + kEps));
+        ++bands;
+    }
+    contrastDb /= float((std::max)(bands, 1));
+
+    result[static_cast<std::size_t>(SpectralFeature::Centroid)] = centroid;
+    result[static_cast<std::size_t>(SpectralFeature::Flatness)] = std::clamp(flatness, 0.0f, 1.0f);
+    result[static_cast<std::size_t>(SpectralFeature::Rolloff)] = rolloff;
+    result[static_cast<std::size_t>(SpectralFeature::Contrast)] = std::clamp(contrastDb / kContrastRangeDb, 0.0f, 1.0f);
+    result[static_cast<std::size_t>(SpectralFeature::Bandwidth)] = sigma;
+    result[static_cast<std::size_t>(SpectralFeature::Entropy)] = std::clamp(entropy, 0.0f, 1.0f);
+    result[static_cast<std::size_t>(SpectralFeature::Flux)] = std::clamp(flux / sumM, 0.0f, 1.0f);
+    result[static_cast<std::size_t>(SpectralFeature::Skewness)] = sigma > kEps ? m3 / (sigma * sigma * sigma) : 0.0f;
+    result[static_cast<std::size_t>(SpectralFeature::Kurtosis)] = sigma > kEps ? m4 / (m2 * m2) : 0.0f;
+
+    std::swap(mag_, prevMag_);
+}
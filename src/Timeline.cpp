@@ -7,7 +7,9 @@
 #include <iostream>
 #include "Canvas.h"
 #include "GraphicObject.h"
+#include "ImportJobs.h"
 #include "Rectangle.h"
+#include "TimelineIndex.h"
 
 namespace Timeline {
 
@@ -33,6 +35,49 @@ namespace Timeline {
 
     std::shared_ptr<Scene> currentScene;
 
+    std::shared_ptr<Scene> sceneAt(float seconds) {
+        const int i = TimelineIndex::sceneAt(seconds * 1000.0f);
+        if (i >= 0)
+            return scenes[i];
+        return scenes.empty() ? nullptr : scenes.back();
+    }
+
+    // One column per visible pixel, from the pyramid level matching the zoom,
+    // so the cost does not depend on how long the track is
+    static void drawWaveform(ImDrawList* draw_list, const TimelineTrack& track, ImVec2 p0, ImVec2 p1) {
+        if (!track.waveform || !track.waveform->ready.load(std::memory_order_acquire))
+            return;
+        const WaveformPyramid& pyramid = *track.waveform->pyramid;
+
+        const float left = (std::max)(p0.x, draw_list->GetClipRectMin().x);
+        const float right = (std::min)(p1.x, draw_list->GetClipRectMax().x);
+        if (right <= left)
+            return;
+
+        const double framesPerPixel = double(track.sampleRate) / (1000.0 * pixelsPerMs);
+        const std::uint32_t level = pyramid.levelFor(framesPerPixel);
+        const float mid = (p0.y + p1.y) * 0.5f;
+        const float halfHeight = (p1.y - p0.y) * 0.5f - 1.0f;
+        const ImU32 peakColor = (track.labelColor & 0x00FFFFFF) | (110u << IM_COL32_A_SHIFT);
+        const ImU32 rmsColor = (track.labelColor & 0x00FFFFFF) | (190u << IM_COL32_A_SHIFT);
+
+        for (float x = std::floor(left); x < right; x += 1.0f) {
+            const double from = (x - p0.x) * framesPerPixel;
+            if (from < 0.0)
+                continue;
+            const std::uint64_t f0 = static_cast<std::uint64_t>(from);
+            const std::uint64_t f1 = static_cast<std::uint64_t>(std::ceil(from + framesPerPixel));
+            const WaveformPeak peak = pyramid.range(level, f0, f1);
+
+            const float top = mid - peak.max / 127.0f * halfHeight;
+            const float bottom = mid - peak.min / 127.0f * halfHeight;
+            draw_list->AddRectFilled(ImVec2(x, top), ImVec2(x + 1.0f, (std::max)(bottom, top + 1.0f)), peakColor);
+
+            const float rms = peak.rms / 255.0f * halfHeight;
+            draw_list->AddRectFilled(ImVec2(x, mid - rms), ImVec2(x + 1.0f, mid + rms), rmsColor);
+        }
+    }
+
     static constexpr float rulerHeight = 20.0f;
     static constexpr float rulerMarginTop = 5.0f;
 
@@ -75,6 +120,7 @@ namespace Timeline {
                 else {
                     std::shared_ptr<Scene> newScene = std::make_shared<Scene>(Scene{ tempSceneStart, tempSceneEnd, tempColor });
                     scenes.push_back(newScene);
+                    TimelineIndex::scenesChanged();
                     isDraggingScene = false;
                 }
 
@@ -97,18 +143,13 @@ namespace Timeline {
                 pixelsPerMs = basePixelsPerMs * zoom;
             }
 
-            // Compute dynamic content width
-            float maxTimelineExtent = userScreenWidth;
-            for (const auto& track : timelineTracks) {
-                float endPx = (track->startTime + track->duration) * 1000.0f * pixelsPerMs;
-                maxTimelineExtent = (std::max)(maxTimelineExtent, endPx) + 100.0;
+            for (const auto& import : ImportJobs::active()) {
+                ImGui::SameLine();
+                ImGui::ProgressBar(import->progress(), ImVec2(140.0f, 0.0f), import->displayName.c_str());
             }
 
-            for (auto& s : scenes) {
-                // s.startTime / endTime are already in ms, so:
-                float sceneEndPx = s->endTime * pixelsPerMs;
-                maxTimelineExtent = (std::max)(maxTimelineExtent, sceneEndPx) + 100.0;
-            }
+            // Compute dynamic content width
+            float maxTimelineExtent = (std::max)(userScreenWidth, TimelineIndex::endMs() * pixelsPerMs + 100.0f);
 
             if (isDraggingScene) {
                 float previewEndPx = tempSceneEnd * pixelsPerMs;
@@ -143,10 +184,17 @@ namespace Timeline {
             float       h = timelineFixedHeight;        // height of the timeline strip
             float       w = userScreenWidth;
 
-            currentScene = nullptr;
             float curTimeInMs = currentTime * 1000.0f;
 
-            for (size_t i{ 0 }; i < scenes.size(); ++i) {
+            // Only the scenes in view are drawn and editable. Edge drags can
+            // squeeze a scene to zero width; it must keep its handles.
+            static std::vector<std::uint32_t> visibleScenes;
+            visibleScenes.clear();
+            TimelineIndex::scenes().touching(scrollX / pixelsPerMs, (scrollX + io.DisplaySize.x) / pixelsPerMs,
+                [](const IntervalIndex::Entry& e) { visibleScenes.push_back(e.id); });
+            std::sort(visibleScenes.begin(), visibleScenes.end());
+
+            for (std::uint32_t i : visibleScenes) {
                 auto& s = scenes[i];
                 float sx = x0 + s->startTime * pixelsPerMs - scrollX;
                 float ex = x0 + s->endTime * pixelsPerMs - scrollX;
@@ -182,6 +230,8 @@ namespace Timeline {
                             float newStart = (mx - x0 + scrollX) / pixelsPerMs;
                             s->startTime = std::clamp(newStart, 0.0f, s->endTime);
                             scenes[i - 1]->endTime = newStart;
+                            TimelineIndex::sceneMoved(i);
+                            TimelineIndex::sceneMoved(i - 1);
                         }
                     }
 
@@ -199,16 +249,18 @@ namespace Timeline {
                         float maxTime = maxTimelineExtent / pixelsPerMs;
                         float newEnd = (mx - x0 + scrollX) / pixelsPerMs;
                         s->endTime = std::clamp(newEnd, s->startTime, maxTime);
-                        if (i < scenes.size() - 1)
+                        TimelineIndex::sceneMoved(i);
+                        if (i < scenes.size() - 1) {
                             scenes[i + 1]->startTime = newEnd;
+                            TimelineIndex::sceneMoved(i + 1);
+                        }
                     }
                 }
-
-                if (curTimeInMs < s->endTime && curTimeInMs >= s->startTime) {
-                    currentScene = scenes[i];
-                }
             }
 
+            const int current = TimelineIndex::sceneAt(curTimeInMs);
+            currentScene = current >= 0 ? scenes[current] : nullptr;
+
             if(!currentScene) {
                 GlobalTransport::isPlaying = false;
 			}
@@ -292,9 +344,11 @@ namespace Timeline {
                 if (track->dragging && track->selected) {
                     float deltaX = mousePos.x - track->dragStartMouseX;
                     float deltaTime = deltaX / (1000.0f * pixelsPerMs);
-                    for (auto& t : timelineTracks) {
+                    for (size_t j = 0; j < timelineTracks.size(); ++j) {
+                        auto& t = timelineTracks[j];
                         if (t->selected) {
                             t->startTime = (std::max)(0.0f, t->dragStartTrackX + deltaTime);
+                            TimelineIndex::trackMoved(j);
                         }
                     }
                 }
@@ -306,6 +360,7 @@ namespace Timeline {
                     drawColor = (track->color & 0x00FFFFFF) | (a << IM_COL32_A_SHIFT);
                 }
                 draw_list->AddRectFilled(p0, p1, drawColor);
+                drawWaveform(draw_list, *track, p0, p1);
 
                 // Clip any subsequent drawing to the inside of [p0,p1]
                 draw_list->PushClipRect(
@@ -360,17 +415,7 @@ namespace Timeline {
             ImGui::End();
         }
         else {
-            currentScene = nullptr;
-            float curTimeInMs = currentTime * 1000.0f;
-            for (size_t i{ 0 }; i < scenes.size(); ++i) {
-                if (curTimeInMs < scenes[i]->endTime && curTimeInMs >= scenes[i]->startTime) {
-                    currentScene = scenes[i];
-                }
-            }
-
-            if (!currentScene) {
-                currentScene = scenes.empty() ? nullptr : scenes.back();
-            }
+            currentScene = sceneAt(currentTime);
         }
     }
 }
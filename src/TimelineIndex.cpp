@@ -0,0 +1,91 @@
+#include "TimelineIndex.h"
+#include "Timeline.h"
+#include <algorithm>
+
+namespace {
+    IntervalIndex sceneIndex;
+    IntervalIndex trackIndex;
+    bool scenesDirty = true;
+    bool tracksDirty = true;
+
+    IntervalIndex::Entry sceneEntry(std::size_t i) {
+        const auto& s = Timeline::scenes[i];
+        return { s->startTime, s->endTime, static_cast<std::uint32_t>(i) };
+    }
+
+    IntervalIndex::Entry trackEntry(std::size_t i) {
+        const auto& t = Timeline::timelineTracks[i];
+        return { t->startTime, t->startTime + t->duration, static_cast<std::uint32_t>(i) };
+    }
+
+    void syncScenes() {
+        if (!scenesDirty && sceneIndex.size() == Timeline::scenes.size())
+            return;
+        std::vector<IntervalIndex::Entry> entries;
+        entries.reserve(Timeline::scenes.size());
+        for (std::size_t i = 0; i < Timeline::scenes.size(); ++i)
+            entries.push_back(sceneEntry(i));
+        sceneIndex.assign(std::move(entries));
+        scenesDirty = false;
+    }
+
+    void syncTracks() {
+        if (!tracksDirty && trackIndex.size() == Timeline::timelineTracks.size())
+            return;
+        std::vector<IntervalIndex::Entry> entries;
+        entries.reserve(Timeline::timelineTracks.size());
+        for (std::size_t i = 0; i < Timeline::timelineTracks.size(); ++i)
+            entries.push_back(trackEntry(i));
+        trackIndex.assign(std::move(entries));
+        tracksDirty = false;
+    }
+}
+
+void TimelineIndex::scenesChanged() { scenesDirty = true; }
+void TimelineIndex::tracksChanged() { tracksDirty = true; }
+
+void TimelineIndex::sceneMoved(std::size_t index) {
+    if (scenesDirty || sceneIndex.size() != Timeline::scenes.size() || index >= Timeline::scenes.size())
+        return;   // rebuilt on the next query anyway
+    const auto e = sceneEntry(index);
+    sceneIndex.update(e.id, e.start, e.end);
+}
+
+void TimelineIndex::trackMoved(std::size_t index) {
+    if (tracksDirty || trackIndex.size() != Timeline::timelineTracks.size() || index >= Timeline::timelineTracks.size())
+        return;
+    const auto e = trackEntry(index);
+    trackIndex.update(e.id, e.start, e.end);
+}
+
+const IntervalIndex& TimelineIndex::scenes() {
+    syncScenes();
+    return sceneIndex;
+}
+
+const IntervalIndex& TimelineIndex::tracks() {
+    syncTracks();
+    return trackIndex;
+}
+
+int TimelineIndex::sceneAt(float ms) {
+    int found = -1;
+    scenes().stab(ms, [&](const IntervalIndex::Entry& e) {
+        found = (std::max)(found, static_cast<int>(e.id));
+    });
+    return found;
+}
+
+int TimelineIndex::nextSceneAfter(float ms) {
+    const std::uint32_t id = scenes().firstStartingAfter(ms);
+    return id == IntervalIndex::none ? -1 : static_cast<int>(id);
+}
+
+float TimelineIndex::endMs() {
+    float end = 0.0f;
+    if (!scenes().empty())
+        end = (std::max)(end, scenes().maxEnd());
+    if (!tracks().empty())
+        end = (std::max)(end, tracks().maxEnd() * 1000.0f);
+    return end;
+}
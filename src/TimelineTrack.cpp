@@ -1,5 +1,9 @@
 #include "TimelineTrack.h"
+#include "AudioEngine.h"
+#include "SidecarJobs.h"
+#include "TrackStreamer.h"
 #include "imgui.h"
+#include <algorithm>
 
 void TimelineTrack::computeComplementaryColor() {
     auto srgbToLinear = [](float c) -> float {
@@ -37,39 +41,54 @@ void TimelineTrack::computeComplementaryColor() {
 }
 
 float TimelineTrack::getParamValue(AudioParameter param) const {
+    // Indexed lookup into the pre-analysed table at the current playhead
+    if (features && features->ready.load(std::memory_order_acquire)) {
+        const FeatureTable& table = *features->table;
+        // The table's envelope is only valid for the smoothing it was analysed with
+        bool staleEnvelope = param == AudioParameter::Envelope
+            && table.smoothingAlpha() != analyzer.getSmoothingCoefficient();
+        if (!staleEnvelope)
+            return table.value(playheadFrame.load(std::memory_order_relaxed), param);
+    }
+
     switch (param) {
     case AudioParameter::Envelope:
         return currentEnvelope;
     case AudioParameter::ZCR:
         return static_cast<float>(analyzer.getZeroCrossingRate());
 	default:
+        if (param >= AudioParameter::SpCentroid && param < AudioParameter::COUNT) {
+            std::size_t sp = static_cast<std::size_t>(param) - static_cast<std::size_t>(AudioParameter::SpCentroid);
+            return analyzer.getSpectralFeature(static_cast<SpectralFeature>(sp));
+        }
         return 0.0f;
     }
 }
 
 void TimelineTrack::updateMappings() {
-    for (std::size_t ap = 0; ap < mappings.size(); ++ap) {
-        auto& v = mappings[ap];
-        v.erase(
-            std::remove_if(
-                v.begin(),
-                v.end(),
-                [](const std::shared_ptr<Mapping>& m) {
-                    return !m->isMapped();   // expired target?
-                }
-            ),
-            v.end()
-        );
-        for (auto& m : v) {
-            std::cout << "i'm mapping\n";
-            m->mapParameter(getParamValue(static_cast<AudioParameter>(ap)));
-        }
+    // Only rebuilt when a mapping was added/edited or its object was deleted
+    if (mappingTable.needsCompile())
+        mappingTable.compile(mappings);
+
+    // Triggers see every block the mixer analysed since the last UI frame
+    FeatureFrame frame;
+    while (featureFrames.pop(frame)) {
+        if (mappingTable.hasTriggers())
+            mappingTable.evaluateTriggers(frame.values);
+    }
+
+    // Sync mappings only need the value at the current playhead
+    if (mappingTable.hasSync()) {
+        float values[static_cast<std::size_t>(AudioParameter::COUNT)];
+        for (std::size_t ap = 0; ap < std::size(values); ++ap)
+            values[ap] = getParamValue(static_cast<AudioParameter>(ap));
+        mappingTable.evaluateSync(values);
     }
 }
 
 bool TimelineTrack::loadTrack(const std::string& path) {
 
-    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, 2, 48000);
+    ma_decoder_config decoderConfig = ma_decoder_config_init(ma_format_f32, 2, AudioEngine::sampleRate);
     if (ma_decoder_init_file(path.c_str(), &decoderConfig, &decoder) != MA_SUCCESS) {
         return false;
     }
@@ -78,18 +97,53 @@ bool TimelineTrack::loadTrack(const std::string& path) {
     playing = false;
     updateDecoderParams();
 
-    ma_uint64 totalFrames = 0;
+    totalFrames = 0;
     ma_decoder_get_length_in_pcm_frames(&decoder, &totalFrames);
+
+    // The decoder stays open so the track can fall back to streaming
+    pcm = PcmCache::acquire(path, static_cast<uint32_t>(sampleRate), channelCount);
+    if (pcm) {
+        totalFrames = pcm->frameCount();
+        pcmView.store(pcm.get(), std::memory_order_release);
+    }
     duration = float(totalFrames) / sampleRate;
 
+    prepareScratch(AudioEngine::maxBlockFrames);
+    ring.allocate(static_cast<std::size_t>(TrackStreamer::maxLookAheadSeconds * sampleRate) * channelCount);
+    featureFrames.allocate(featureQueueFrames);
+
+    // Both analyses share one mapping and one hash of the file, and read the
+    // in-memory copy rather than decoding it again when there is one
+    auto source = std::make_shared<const SidecarSource>(path, pcm);
+    features = FeatureCache::request(source, static_cast<uint32_t>(sampleRate),
+        analyzer.getSmoothingCoefficient());
+    waveform = WaveformCache::request(source, static_cast<uint32_t>(sampleRate));
+
     return true;
 }
 
+void TimelineTrack::detachPcm() {
+    pcmView.store(nullptr, std::memory_order_release);
+    pcm.reset();
+}
+
+void TimelineTrack::prepareScratch(uint32_t maxFrames) {
+    scratch.assign(static_cast<std::size_t>(maxFrames) * channelCount, 0.0f);
+}
+
+float TimelineTrack::bufferedSeconds() const {
+    return float(ring.readAvailable() / channelCount) / sampleRate;
+}
+
 void TimelineTrack::playTrack(float timelineTime) {
+    float localTime = (std::max)(0.0f, timelineTime - startTime);
+    uint64_t frame = uint64_t(double(localTime) * sampleRate);
+    seekFrame.store(frame, std::memory_order_relaxed);
+    playheadFrame.store(frame, std::memory_order_relaxed);
+    featureFrames.discardTo(featureFrames.writeIndex());   // drop blocks from before the jump
+    seekRequest.fetch_add(1, std::memory_order_release);
     playing = true;
-    nextFrame = uint64_t((timelineTime - startTime) * sampleRate);
-    if (nextFrame < 0) nextFrame = 0;
-    ma_decoder_seek_to_pcm_frame(&decoder, nextFrame);
+    TrackStreamer::wake();
 }
 
 void TimelineTrack::stopTrack() {
@@ -0,0 +1,175 @@
+#include "Trace.h"
+#include "SpscRing.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Trace {
+
+    std::atomic<bool> enabled{ false };
+
+    static constexpr std::size_t ringEvents = 4096;   // per thread
+    static constexpr auto drainInterval = std::chrono::milliseconds(20);
+
+    struct ThreadBuffer {
+        SpscRing<Event> ring;
+        std::atomic<std::uint32_t> dropped{ 0 };
+        std::uint32_t id = 0;
+    };
+
+    static std::mutex registryMutex;
+    static std::vector<std::shared_ptr<ThreadBuffer>> registry;
+    static std::atomic<std::uint32_t> nextThreadId{ 0 };
+
+    static std::thread drainer;
+    static std::mutex drainMutex;
+    static std::condition_variable drainCv;
+    static bool running = false;
+    static std::FILE* out = nullptr;
+
+    static const auto epoch = std::chrono::steady_clock::now();
+
+    static ThreadBuffer& localBuffer() {
+        thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+            auto b = std::make_shared<ThreadBuffer>();
+            b->ring.allocate(ringEvents);
+            b->id = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(registryMutex);
+            registry.push_back(b);
+            return b;
+        }();
+        return *buffer;
+    }
+
+    void registerThread() {
+        localBuffer();
+    }
+
+    void push(Event& e) {
+        ThreadBuffer& buffer = localBuffer();
+        e.timeNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch).count());
+        e.thread = buffer.id;
+        if (!buffer.ring.push(e))
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // ─── Drainer side: formatting only ever happens here ───
+    static const char* levelName(Level level) {
+        switch (level) {
+        case Level::Error:   return "ERROR";
+        case Level::Info:    return "INFO ";
+        case Level::Debug:   return "DEBUG";
+        default:             return "VERB ";
+        }
+    }
+
+    static void writeArg(std::FILE* f, const ArgValue& v, ArgKind kind) {
+        switch (kind) {
+        case ArgKind::Int:   std::fprintf(f, "%lld", static_cast<long long>(v.i)); break;
+        case ArgKind::Uint:  std::fprintf(f, "%llu", static_cast<unsigned long long>(v.u)); break;
+        case ArgKind::Float: std::fprintf(f, "%g", v.f); break;
+        case ArgKind::Bool:  std::fputs(v.u ? "true" : "false", f); break;
+        case ArgKind::Str:   std::fputs(v.s ? v.s : "(null)", f); break;
+        default: break;
+        }
+    }
+
+    static void writeEvent(std::FILE* f, const Event& e) {
+        std::fprintf(f, "%12.6f [T%u] %s ", double(e.timeNs) * 1e-9, e.thread, levelName(e.level));
+
+        std::size_t arg = 0;
+        for (const char* p = e.format; *p; ++p) {
+            if (p[0] == '{' && p[1] == '}' && arg < 4) {
+                writeArg(f, e.args[arg], e.kinds[arg]);
+                ++arg;
+                ++p;
+            }
+            else {
+                std::fputc(*p, f);
+            }
+        }
+        std::fputc('\n', f);
+    }
+
+    static void drainOnce(std::vector<Event>& batch) {
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            buffers = registry;
+        }
+
+        batch.clear();
+        for (auto& b : buffers) {
+            Event e;
+            while (b->ring.pop(e))
+                batch.push_back(e);
+
+            std::uint32_t dropped = b->dropped.exchange(0, std::memory_order_relaxed);
+            if (dropped > 0 && out)
+                std::fprintf(out, "[trace] thread %u dropped %u events\n", b->id, dropped);
+        }
+
+        // Rings are per thread; interleave them back into one timeline
+        std::stable_sort(batch.begin(), batch.end(),
+            [](const Event& a, const Event& b) { return a.timeNs < b.timeNs; });
+
+        if (!out)
+            return;
+        for (const Event& e : batch)
+            writeEvent(out, e);
+        std::fflush(out);
+    }
+
+    static void drainLoop() {
+        std::vector<Event> batch;
+        batch.reserve(ringEvents);
+
+        std::unique_lock<std::mutex> lock(drainMutex);
+        while (running) {
+            drainCv.wait_for(lock, drainInterval);
+            lock.unlock();
+            drainOnce(batch);
+            lock.lock();
+        }
+        lock.unlock();
+        drainOnce(batch);
+    }
+
+    void start(const std::string& path) {
+        if (drainer.joinable())
+            return;
+
+        out = std::fopen(path.c_str(), "w");
+        if (!out) {
+            std::cerr << "Could not open trace file " << path << "\n";
+            return;
+        }
+
+        running = true;
+        drainer = std::thread(drainLoop);
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void stop() {
+        if (!drainer.joinable())
+            return;
+
+        enabled.store(false, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(drainMutex);
+            running = false;
+        }
+        drainCv.notify_all();
+        drainer.join();
+
+        std::fclose(out);
+        out = nullptr;
+    }
+}
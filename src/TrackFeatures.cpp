@@ -4,6 +4,7 @@
 #include "imgui.h"
 #include "MappingsWindow.h"
 #include "ScenesPanel.h"
+#include "TrackStreamer.h"
 #include <cmath>
 
 namespace TrackFeatures {
@@ -70,6 +71,22 @@ namespace TrackFeatures {
 
             ImGui::Separator();
 
+            // Streaming health
+            ImGui::Text("Buffer: %.0f ms  Underruns: %u",
+                selectedTrack->bufferedSeconds() * 1000.0f,
+                selectedTrack->underruns.load(std::memory_order_relaxed));
+
+            bool featuresReady = selectedTrack->features
+                && selectedTrack->features->ready.load(std::memory_order_acquire);
+            ImGui::Text("Features: %s", featuresReady ? "pre-analysed" : "live (analysing...)");
+
+            float lookAhead = TrackStreamer::lookAheadSeconds.load(std::memory_order_relaxed);
+            if (ImGui::SliderFloat("Look-ahead", &lookAhead, 0.05f, TrackStreamer::maxLookAheadSeconds, "%.2f s")) {
+                TrackStreamer::lookAheadSeconds.store(lookAhead, std::memory_order_relaxed);
+            }
+
+            ImGui::Separator();
+
             float env = selectedTrack->analyzer.getSmoothedEnvelope();
             float alpha = selectedTrack->analyzer.getSmoothingAlpha(selectedTrack->sampleRate);
             int zcr = selectedTrack->analyzer.getZeroCrossingRate();
@@ -126,6 +143,27 @@ namespace TrackFeatures {
                 p_index = 1;
             }
 
+            // Spectral features, all derived from one STFT per hop
+            for (std::size_t sp = 0; sp < static_cast<std::size_t>(SpectralFeature::COUNT); ++sp) {
+                std::size_t pi = static_cast<std::size_t>(AudioParameter::SpCentroid) + sp;
+
+                ImGui::Separator();
+                ImVec2 rowPos = ImGui::GetCursorScreenPos();
+                if (showMappings && p_index == pi) {
+                    dl->AddRectFilled(
+                        rowPos,
+                        { rowPos.x + avail, rowPos.y + lh },
+                        IM_COL32(255, 127, 0, 100)
+                    );
+                }
+
+                float value = selectedTrack->getParamValue(static_cast<AudioParameter>(pi));
+                ImGui::Text("%s: %.3f", parameters[pi].c_str(), value);
+                if (showMappings && ImGui::IsItemClicked()) {
+                    p_index = pi;
+                }
+            }
+
             if (showMappings)
                 MappingsWindow::showMappingsWindow(selectedTrack, parameters[p_index], p_index);
         }
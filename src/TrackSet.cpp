@@ -0,0 +1,92 @@
+#include "TrackSet.h"
+#include "Timeline.h"
+#include "TimelineTrack.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace TrackSet {
+
+    struct Retired {
+        std::uint64_t epoch;                       // first epoch no reader can see this in
+        std::unique_ptr<const Snapshot> snapshot;
+        std::vector<std::unique_ptr<TimelineTrack>> tracks;
+        std::shared_ptr<const void> resource;
+    };
+
+    static const Snapshot emptySnapshot;
+    static std::atomic<const Snapshot*> current{ &emptySnapshot };
+    static std::unique_ptr<const Snapshot> owned;  // what `current` points at, once published
+
+    // Epochs are only ever compared, so 0 can mean "not reading"
+    static std::atomic<std::uint64_t> epoch{ 1 };
+    static std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(Reader::COUNT)> readers{};
+
+    static std::vector<Retired> retired;   // UI thread only
+
+    // The epoch is announced before the pointer is read; publish() swaps the
+    // pointer before advancing the epoch. So a reader still announcing an
+    // older epoch may hold the old snapshot, and one announcing a newer epoch
+    // cannot. Everything here is sequentially consistent for that argument.
+    Guard::Guard(Reader reader) : reader_(reader) {
+        readers[static_cast<std::size_t>(reader)].store(epoch.load());
+        snapshot_ = current.load();
+    }
+
+    Guard::~Guard() {
+        readers[static_cast<std::size_t>(reader_)].store(0);
+    }
+
+    static void release(Retired& r) {
+        for (auto& track : r.tracks)
+            track->unloadTrack();
+        r.tracks.clear();
+        r.snapshot.reset();
+        r.resource.reset();
+    }
+
+    void publish(std::vector<std::unique_ptr<TimelineTrack>> tracks) {
+        auto next = std::make_unique<Snapshot>();
+        next->tracks.reserve(Timeline::timelineTracks.size());
+        for (auto& track : Timeline::timelineTracks)
+            next->tracks.push_back(track.get());
+
+        current.store(next.get());
+        const std::uint64_t swapped = epoch.fetch_add(1) + 1;
+
+        retired.push_back({ swapped, std::move(owned), std::move(tracks), nullptr });
+        owned = std::move(next);
+        reclaim();
+    }
+
+    void defer(std::shared_ptr<const void> resource) {
+        const std::uint64_t swapped = epoch.fetch_add(1) + 1;
+        retired.push_back({ swapped, nullptr, {}, std::move(resource) });
+        reclaim();
+    }
+
+    void reclaim() {
+        std::uint64_t oldest = UINT64_MAX;
+        for (auto& reader : readers) {
+            const std::uint64_t e = reader.load();
+            if (e != 0 && e < oldest)
+                oldest = e;
+        }
+
+        retired.erase(std::remove_if(retired.begin(), retired.end(), [oldest](Retired& r) {
+            if (r.epoch > oldest)
+                return false;
+            release(r);
+            return true;
+        }), retired.end());
+    }
+
+    void shutdown() {
+        current.store(&emptySnapshot);
+        for (auto& r : retired)
+            release(r);
+        retired.clear();
+        owned.reset();
+    }
+}
@@ -0,0 +1,129 @@
+#include "TrackStreamer.h"
+#include "TimelineTrack.h"
+#include "TrackSet.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TrackStreamer {
+
+    std::atomic<float> lookAheadSeconds{ 0.5f };
+
+    static std::thread worker;
+    static std::atomic<bool> running{ false };
+    static std::mutex wakeMutex;
+    static std::condition_variable wakeCv;
+    static bool woken = false;
+
+    // Seeks the decoder and tells the consumer where the new data begins
+    static void serviceSeek(TimelineTrack& track) {
+        uint32_t gen = track.seekRequest.load(std::memory_order_acquire);
+        if (gen == track.seekServed.load(std::memory_order_relaxed))
+            return;
+
+        uint64_t frame = track.seekFrame.load(std::memory_order_relaxed);
+        ma_decoder_seek_to_pcm_frame(&track.decoder, frame);
+        track.decodeFrame = frame;
+        track.decodeEof = false;
+
+        track.seekFlushIndex.store(track.ring.writeIndex(), std::memory_order_relaxed);
+        track.seekServedFrame.store(frame, std::memory_order_relaxed);
+        track.seekServed.store(gen, std::memory_order_release);
+    }
+
+    // Decodes one chunk into the track's ring. Returns false when nothing was written.
+    static bool refill(TimelineTrack& track, std::vector<float>& chunk, std::size_t targetSamples) {
+        if (track.decodeEof)
+            return false;
+
+        const std::size_t ch = track.channelCount;
+        std::size_t buffered = track.ring.readAvailable();
+        if (buffered >= targetSamples)
+            return false;
+
+        std::size_t frames = (std::min)(track.ring.writeAvailable(), targetSamples - buffered) / ch;
+        frames = (std::min)(frames, static_cast<std::size_t>(decodeChunkFrames));
+        if (frames == 0)
+            return false;
+
+        ma_uint64 framesRead = 0;
+        ma_decoder_read_pcm_frames(&track.decoder, chunk.data(), frames, &framesRead);
+        if (framesRead < frames)
+            track.decodeEof = true;
+
+        track.ring.write(chunk.data(), static_cast<std::size_t>(framesRead) * ch);
+        track.decodeFrame += framesRead;
+        return framesRead > 0;
+    }
+
+    static void run() {
+        std::vector<float> chunk(static_cast<std::size_t>(decodeChunkFrames) * 8);
+        std::vector<std::pair<std::size_t, TimelineTrack*>> queue;
+
+        while (running.load(std::memory_order_acquire)) {
+            bool wroteAny = false;
+            {
+                // Held until the refills are done; the tracks in `queue` come from it
+                TrackSet::Guard guard(TrackSet::Reader::Streamer);
+                queue.clear();
+                for (TimelineTrack* track : guard.tracks()) {
+                    if (!track->decoderInitialized || track->pcmView.load(std::memory_order_acquire))
+                        continue;
+                    serviceSeek(*track);
+                    if (!track->playing)
+                        continue;
+                    // Frames left in the ring before the callback starves
+                    queue.emplace_back(track->ring.readAvailable() / track->channelCount, track);
+                }
+
+                // Closest to an underrun gets decoded first
+                std::sort(queue.begin(), queue.end(),
+                    [](const auto& a, const auto& b) { return a.first < b.first; });
+
+                for (auto& [fill, track] : queue) {
+                    float ahead = std::clamp(lookAheadSeconds.load(std::memory_order_relaxed), 0.05f, maxLookAheadSeconds);
+                    std::size_t target = (std::min)(
+                        static_cast<std::size_t>(ahead * track->sampleRate) * track->channelCount,
+                        track->ring.capacity());
+                    if (chunk.size() < static_cast<std::size_t>(decodeChunkFrames) * track->channelCount)
+                        chunk.resize(static_cast<std::size_t>(decodeChunkFrames) * track->channelCount);
+
+                    // Service pending seeks between chunks so a jump never waits for a full refill
+                    serviceSeek(*track);
+                    wroteAny |= refill(*track, chunk, target);
+                }
+            }
+
+            if (!wroteAny) {
+                std::unique_lock<std::mutex> lock(wakeMutex);
+                wakeCv.wait_for(lock, std::chrono::milliseconds(5), [] { return woken; });
+                woken = false;
+            }
+        }
+    }
+
+    void start() {
+        if (running.exchange(true))
+            return;
+        worker = std::thread(run);
+    }
+
+    void stop() {
+        if (!running.exchange(false))
+            return;
+        wake();
+        if (worker.joinable())
+            worker.join();
+    }
+
+    void wake() {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            woken = true;
+        }
+        wakeCv.notify_one();
+    }
+}
@@ -0,0 +1,207 @@
+#include "WaveformCache.h"
+#include "MappedFile.h"
+#include "SidecarJobs.h"
+#include "miniaudio.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace WaveformCache {
+
+    static constexpr std::uint32_t sidecarVersion = 1;
+    static constexpr std::uint32_t decodeFrames = 4096;
+
+    // On-disk layout: this header, then every level's peaks, level 0 first
+    struct SidecarHeader {
+        char          magic[4];
+        std::uint32_t version;
+        std::uint64_t contentHash;
+        std::uint32_t sampleRate;
+        std::uint32_t baseFrames;
+        std::uint32_t levelCount;
+        std::uint32_t reserved;
+        std::uint64_t frameCount;
+        std::uint64_t peakCount;
+    };
+    static_assert(sizeof(SidecarHeader) == 48, "sidecar header must stay packed");
+
+    static SidecarHeader makeHeader(std::uint64_t hash, std::uint32_t sampleRate) {
+        SidecarHeader h{};
+        std::memcpy(h.magic, "EZP1", 4);
+        h.version = sidecarVersion;
+        h.contentHash = hash;
+        h.sampleRate = sampleRate;
+        h.baseFrames = WaveformPyramid::baseFrames;
+        return h;
+    }
+
+    static bool sameSettings(const SidecarHeader& a, const SidecarHeader& b) {
+        return std::memcmp(a.magic, b.magic, 4) == 0
+            && a.version == b.version
+            && a.contentHash == b.contentHash
+            && a.sampleRate == b.sampleRate
+            && a.baseFrames == b.baseFrames;
+    }
+
+    // Maps an existing sidecar if it was produced from the same bytes and settings
+    static std::shared_ptr<const WaveformPyramid> mapSidecar(const std::string& path,
+        const SidecarHeader& want) {
+        auto file = std::make_shared<MappedFile>();
+        if (!file->open(path) || file->size() < sizeof(SidecarHeader))
+            return nullptr;
+
+        SidecarHeader have;
+        std::memcpy(&have, file->data(), sizeof(have));
+        if (!sameSettings(have, want)
+            || have.levelCount != WaveformPyramid::levelsFor(have.frameCount)
+            || have.peakCount != WaveformPyramid::totalPeaks(have.frameCount))
+            return nullptr;
+
+        const std::size_t bytes = sizeof(SidecarHeader)
+            + static_cast<std::size_t>(have.peakCount) * sizeof(WaveformPeak);
+        if (file->size() < bytes)
+            return nullptr;
+
+        const auto* peaks = reinterpret_cast<const WaveformPeak*>(file->data() + sizeof(SidecarHeader));
+        return std::make_shared<WaveformPyramid>(file, peaks, have.frameCount, have.levelCount);
+    }
+
+    static WaveformPeak quantise(float lo, float hi, float rms) {
+        WaveformPeak p;
+        p.min = static_cast<std::int8_t>(std::clamp(std::floor(lo * 127.0f), -127.0f, 127.0f));
+        p.max = static_cast<std::int8_t>(std::clamp(std::ceil(hi * 127.0f), -127.0f, 127.0f));
+        p.rms = static_cast<std::uint8_t>(std::clamp(std::ceil(rms * 255.0f), 0.0f, 255.0f));
+        return p;
+    }
+
+    // Reads the whole file once into level 0, then halves it level by level
+    static bool build(const SidecarSource& source, std::uint32_t sampleRate,
+        std::vector<WaveformPeak>& peaks, std::uint64_t& frameCount, std::atomic<float>& progress) {
+        SidecarReader reader(source, sampleRate, 2);
+        if (!reader.valid())
+            return false;
+
+        const std::uint32_t ch = reader.channels();
+        const std::uint64_t lengthFrames = reader.lengthFrames();
+        peaks.reserve(static_cast<std::size_t>(WaveformPyramid::totalPeaks(lengthFrames)));
+
+        std::vector<float> block(static_cast<std::size_t>(decodeFrames) * ch);
+        float lo = 0.0f, hi = 0.0f;
+        double sumSq = 0.0;
+        std::uint32_t inBucket = 0;
+        frameCount = 0;
+
+        auto closeBucket = [&] {
+            const float rms = static_cast<float>(std::sqrt(sumSq / (double(inBucket) * ch)));
+            peaks.push_back(quantise(lo, hi, rms));
+            lo = hi = 0.0f;
+            sumSq = 0.0;
+            inBucket = 0;
+        };
+
+        for (;;) {
+            if (SidecarJobs::cancelled())
+                break;
+
+            const std::uint64_t framesRead = reader.read(block.data(), decodeFrames);
+            if (framesRead == 0)
+                break;
+
+            for (ma_uint64 f = 0; f < framesRead; ++f) {
+                const float* frame = block.data() + f * ch;
+                for (std::uint32_t c = 0; c < ch; ++c) {
+                    lo = (std::min)(lo, frame[c]);
+                    hi = (std::max)(hi, frame[c]);
+                    sumSq += double(frame[c]) * frame[c];
+                }
+                if (++inBucket == WaveformPyramid::baseFrames)
+                    closeBucket();
+            }
+            frameCount += framesRead;
+            if (lengthFrames > 0)
+                progress.store((std::min)(1.0f, float(double(frameCount) / double(lengthFrames))),
+                    std::memory_order_relaxed);
+
+            if (framesRead < decodeFrames)
+                break;
+        }
+        if (inBucket > 0)
+            closeBucket();
+
+        if (SidecarJobs::cancelled() || peaks.empty())
+            return false;
+
+        // Each level above merges pairs of buckets from the one below
+        std::size_t below = 0;
+        std::uint64_t n = peaks.size();
+        const std::uint32_t levels = WaveformPyramid::levelsFor(frameCount);
+        for (std::uint32_t l = 1; l < levels; ++l) {
+            for (std::uint64_t b = 0; b < n; b += 2) {
+                WaveformPeak a = peaks[below + b];
+                WaveformPeak merged = a;
+                if (b + 1 < n) {
+                    const WaveformPeak c = peaks[below + b + 1];
+                    merged.min = (std::min)(a.min, c.min);
+                    merged.max = (std::max)(a.max, c.max);
+                    merged.rms = static_cast<std::uint8_t>((std::min)(255.0f,
+                        std::ceil(std::sqrt((float(a.rms) * a.rms + float(c.rms) * c.rms) * 0.5f))));
+                }
+                peaks.push_back(merged);
+            }
+            below += static_cast<std::size_t>(n);
+            n = (n + 1) / 2;
+        }
+        return true;
+    }
+
+    static void runJob(const SidecarSource& source, std::uint32_t sampleRate,
+        const std::shared_ptr<WaveformSlot>& slot) {
+        if (!source.prepare()) {
+            std::cerr << "Waveform overview could not open " << source.path() << "\n";
+            slot->failed.store(true, std::memory_order_release);
+            return;
+        }
+
+        const SidecarHeader want = makeHeader(source.contentHash(), sampleRate);
+        const std::string sidecar = source.path() + ".ezpk";
+
+        std::shared_ptr<const WaveformPyramid> pyramid = mapSidecar(sidecar, want);
+        if (!pyramid) {
+            auto peaks = std::make_shared<std::vector<WaveformPeak>>();
+            std::uint64_t frameCount = 0;
+            if (!build(source, sampleRate, *peaks, frameCount, slot->progress)) {
+                slot->failed.store(true, std::memory_order_release);
+                return;
+            }
+
+            SidecarHeader header = want;
+            header.frameCount = frameCount;
+            header.levelCount = WaveformPyramid::levelsFor(frameCount);
+            header.peakCount = peaks->size();
+
+            if (SidecarJobs::write(sidecar, &header, sizeof(header),
+                    peaks->data(), peaks->size() * sizeof(WaveformPeak)))
+                pyramid = mapSidecar(sidecar, want);
+
+            if (!pyramid) {
+                // Read-only location: keep the overview in memory for this session
+                pyramid = std::make_shared<WaveformPyramid>(peaks, peaks->data(), frameCount,
+                    header.levelCount);
+            }
+        }
+
+        slot->pyramid = std::move(pyramid);
+        slot->progress.store(1.0f, std::memory_order_relaxed);
+        slot->ready.store(true, std::memory_order_release);
+    }
+
+    std::shared_ptr<WaveformSlot> request(std::shared_ptr<const SidecarSource> source,
+        std::uint32_t sampleRate) {
+        auto slot = std::make_shared<WaveformSlot>();
+        SidecarJobs::submit(
+            [source, sampleRate, slot] { runJob(*source, sampleRate, slot); },
+            [slot] { slot->failed.store(true, std::memory_order_release); });
+        return slot;
+    }
+}
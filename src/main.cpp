@@ -10,21 +10,37 @@
 #include "ImGuiFileDialogConfig.h"
 #include "ImGuiFileDialog.h"
 
+#include "AnimationSystem.h"
+#include "AudioEngine.h"
+#include "HeadlessContext.h"
+#include "ImportJobs.h"
+#include "OfflineRenderer.h"
+#include "PcmCache.h"
+#include "ProjectIO.h"
+#include "TrackStreamer.h"
+#include "TrackSet.h"
+#include "AudioClock.h"
 #include "TimelineTrack.h"
 #include "GlobalTransport.h"
 #include "Timeline.h"
 #include "FileDialogHelper.h"
 #include "TrackFeatures.h"
 #include "ScenesPanel.h"
+#include "ScenePreloader.h"
 #include "Canvas.h"
 #include "Shader.h"
 #include "MappingsWindow.h"
 #include "Style.h"
+#include "Trace.h"
+#include "SidecarJobs.h"
 
 #include <iostream>
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <vector>
 #include <filesystem>
+#include <string>
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
@@ -32,61 +48,129 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     Canvas::recreate(width, height);
 }
 
-void my_audio_callback(ma_device* pDevice, void* pOutput, const void* pInput, ma_uint32 frameCount)
-{
-    float* out = (float*)pOutput;
-    memset(out, 0, frameCount * 2 * sizeof(float)); // Stereo, silence
+// Dropped files import in parallel, placed at the playhead
+void drop_callback(GLFWwindow* window, int count, const char** paths) {
+    for (int i = 0; i < count; ++i)
+        ImportJobs::request(paths[i], GlobalTransport::currentTime);
+}
 
-    for (auto& track : Timeline::timelineTracks) {
-        if (!track->decoderInitialized || !track->playing || track->muted)
-            continue;
-
-        // Seek decoder if needed
-        ma_decoder_seek_to_pcm_frame(&track->decoder, track->nextFrame);
-
-        std::vector<float> tempBuf(frameCount * track->channelCount, 0.0f);
-        ma_uint64 framesRead = 0;
-        ma_decoder_read_pcm_frames(&track->decoder, tempBuf.data(), frameCount, &framesRead);
-
-        // Mix into output buffer (ALWAYS outputting stereo)
-        for (ma_uint64 f = 0; f < framesRead; ++f) {
-            float L = tempBuf[f * track->channelCount + 0];
-            float R = (track->channelCount > 1) ? tempBuf[f * track->channelCount + 1] : L;
-            out[f * 2 + 0] += L;
-            out[f * 2 + 1] += R;
+std::filesystem::path getProjectRelativePath(const std::string& relativePathFromRoot) {
+    std::filesystem::path base = std::filesystem::current_path();
+    for (int i = 0; i < 3; ++i)
+        base = base.parent_path();
+
+    return base / relativePathFromRoot;
+}
+
+// ─── Offline rendering from the command line ───
+// --render <base> writes <base>.y4m and <base>.wav; --video/--audio override
+// either path ("-" is stdout) and --software rasterises on the CPU.
+// --project opens a saved show first and --export-json dumps it.
+// --pcm-cache <MB> decodes tracks into memory within that budget, as 16-bit
+// samples with --pcm-int16; it applies interactively too. Returns false when
+// --render was not given.
+static bool parseRenderArgs(int argc, char** argv, OfflineRenderer::Settings& settings,
+    std::string& projectPath, std::string& jsonPath) {
+    bool render = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--project" && hasValue) projectPath = argv[++i];
+        else if (arg == "--export-json" && hasValue) jsonPath = argv[++i];
+        else if (arg == "--render" && hasValue) {
+            std::string base = argv[++i];
+            settings.videoPath = base + ".y4m";
+            settings.audioPath = base + ".wav";
+            render = true;
+        }
+        else if (arg == "--video" && hasValue) settings.videoPath = argv[++i];
+        else if (arg == "--audio" && hasValue) settings.audioPath = argv[++i];
+        else if (arg == "--fps" && hasValue) settings.fps = std::atoi(argv[++i]);
+        else if (arg == "--start" && hasValue) settings.start = float(std::atof(argv[++i]));
+        else if (arg == "--end" && hasValue) settings.end = float(std::atof(argv[++i]));
+        else if (arg == "--threads" && hasValue) {
+            settings.encodeThreads = unsigned(std::atoi(argv[++i]));
+            settings.rasterThreads = settings.encodeThreads;
         }
+        else if (arg == "--software") settings.software = true;
+        else if (arg == "--pcm-cache" && hasValue) {
+            PcmCache::enabled = true;
+            PcmCache::budgetBytes = std::size_t(std::atoll(argv[++i])) << 20;
+        }
+        else if (arg == "--pcm-int16") PcmCache::format = PcmBuffer::Format::Int16;
+        else if (arg == "--size" && hasValue) {
+            int w = 0, h = 0;
+            if (std::sscanf(argv[++i], "%dx%d", &w, &h) == 2 && w > 0 && h > 0) {
+                settings.width = w;
+                settings.height = h;
+            }
+            else {
+                std::cerr << "Ignoring --size " << argv[i] << ", expected WIDTHxHEIGHT\n";
+            }
+        }
+        else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+        }
+    }
+    return render;
+}
 
-        // ─── Audio-feature extraction (envelope + ZCR) ──────────────────────
-        track->analyzer.analyze(       /* analyzes this block */
-            tempBuf.data(),        // pointer to interleaved samples
-            framesRead,            // number of *frames* we actually decoded
-            track->channelCount);  // 1 for mono, 2 for stereo
+// No window, no ImGui and no playback device: the timeline is stepped at a
+// fixed frame rate and written to disk as fast as the machine allows
+static int renderHeadless(const OfflineRenderer::Settings& settings) {
+    // The software rasteriser needs no GL context at all
+    const bool gl = !settings.software;
+    if (gl) {
+        if (!HeadlessContext::create())
+            return -1;
+
+        Canvas::init(settings.width, settings.height);
+        Canvas::shader = std::make_unique<Shader>("vertex.glsl", "fragment.glsl");
+    }
 
-        track->currentEnvelope.store(track->analyzer.getSmoothedEnvelope(),
-            std::memory_order_relaxed);
+#if EZVZ_TRACE_LEVEL > 0
+    Trace::start("ezvz-trace.log");
+#endif
 
+    TrackStreamer::start();
+    bool ok = OfflineRenderer::render(settings);
 
-        // Advance playback pointer
-        track->nextFrame += framesRead;
+    TrackStreamer::stop();
+    TrackSet::shutdown();
+    PcmCache::shutdown();
+    SidecarJobs::shutdown();
+    Trace::stop();
 
-        // End/loop handling (optionally)
-        ma_uint64 totalFrames = 0;
-        ma_decoder_get_length_in_pcm_frames(&track->decoder, &totalFrames);
-        if (track->nextFrame >= totalFrames) {
-            track->playing = false; // or set nextFrame=0 to loop
-        }
+    for (auto& track : Timeline::timelineTracks) {
+        track->unloadTrack();
     }
-}
 
-std::filesystem::path getProjectRelativePath(const std::string& relativePathFromRoot) {
-    std::filesystem::path base = std::filesystem::current_path();
-    for (int i = 0; i < 3; ++i)
-        base = base.parent_path();
-
-    return base / relativePathFromRoot;
+    if (gl) {
+        Canvas::shader.reset();
+        Canvas::shutdown();
+        HeadlessContext::destroy();
+    }
+    return ok ? 0 : 1;
 }
 
-int main() {
+int main(int argc, char** argv) {
+    OfflineRenderer::Settings renderSettings;
+    std::string projectPath, jsonPath;
+    const bool headless = parseRenderArgs(argc, argv, renderSettings, projectPath, jsonPath);
+    const bool batch = headless || !jsonPath.empty();
+
+    // Nothing is playing yet, so the project can be swapped in directly
+    if (!projectPath.empty() && !ProjectIO::load(projectPath) && batch)
+        return 1;
+    if (!jsonPath.empty()) {
+        if (!ProjectIO::exportJson(jsonPath))
+            return 1;
+        if (!headless)
+            return 0;
+    }
+    if (headless)
+        return renderHeadless(renderSettings);
+
     // Initialize GLFW
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW\n";
@@ -108,6 +192,7 @@ int main() {
     glfwMakeContextCurrent(window);
     glfwSwapInterval(1);
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetDropCallback(window, drop_callback);
 
     // Load OpenGL functions via GLAD
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
@@ -148,29 +233,23 @@ int main() {
     Canvas::init(screenW, screenH);
     Canvas::shader = std::make_unique<Shader>("vertex.glsl", "fragment.glsl");
 
-    ma_device_config config = ma_device_config_init(ma_device_type_playback);
-    config.playback.format = ma_format_f32;
-    config.playback.channels = 2; // stereo
-    config.sampleRate = 48000;
-    config.dataCallback = my_audio_callback; // <-- your function
-    config.pUserData = nullptr;
+#if EZVZ_TRACE_LEVEL > 0
+    Trace::start("ezvz-trace.log");
+#endif
 
     ma_device device;
-    ma_result result = ma_device_init(NULL, &config, &device);
-    if (result != MA_SUCCESS) {
-        std::cerr << "Device was unable to be initialized. Closing program.";
+    if (!AudioEngine::init(device)) {
+        std::cerr << "Closing program.";
 		return -1;
     }
-    ma_device_start(&device);
+    AudioEngine::start(device);
+    TrackStreamer::start();
 
     // Main loop
     while (!glfwWindowShouldClose(window)) {
         glfwPollEvents();
-        if (Timeline::currentScene && GlobalTransport::isPlaying) {
-            for (auto& obj : Timeline::currentScene->objects) {
-                obj->update();
-            }
-        }
+        if (Timeline::currentScene && GlobalTransport::isPlaying)
+            AnimationSystem::update(*Timeline::currentScene);
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -189,24 +268,23 @@ int main() {
                     if(Timeline::currentScene)
                         GlobalTransport::currentTime = Timeline::currentScene->startTime / 1000.0f;
 
-                    GlobalTransport::playStartTime = glfwGetTime() - GlobalTransport::currentTime;
-					std::cout << "current time = " << GlobalTransport::currentTime << "\n";
+                    GlobalTransport::play();
+					TRACE_INFO("current time = {}", GlobalTransport::currentTime);
                 }
 
                 for (auto& scene : Timeline::scenes) {
-                    std::cout << "I am resetting all of the scenes yo\n";
+                    TRACE_DEBUG("Resetting all scene animations");
                     scene->resetObjectAnimations();
                 }
             }
         }
 
         if (GlobalTransport::isPlaying) {
-            float now = glfwGetTime();
-            GlobalTransport::currentTime = now - GlobalTransport::playStartTime;
+            // Visuals follow what is audible; tracks follow what the mixer is writing
+            GlobalTransport::currentTime = float(AudioClock::audibleTime());
             if (GlobalTransport::currentTime >= GlobalTransport::totalTime) {
                 if (GlobalTransport::isLooping) {
-                    GlobalTransport::playStartTime = now;
-                    GlobalTransport::currentTime = 0.0f;
+                    GlobalTransport::seek(0.0f);
                 }
                 else {
                     GlobalTransport::currentTime = GlobalTransport::totalTime;
@@ -214,12 +292,12 @@ int main() {
                 }
             }
 
-			float currentTime = GlobalTransport::currentTime;
+			float renderTime = float(AudioClock::renderTime());
             for (auto& track : Timeline::timelineTracks) {
-                bool inRegion = (currentTime >= track->startTime) && (currentTime < track->startTime + track->duration);
+                bool inRegion = (renderTime >= track->startTime) && (renderTime < track->startTime + track->duration);
 
                 if (inRegion && !track->playing) {
-                    track->playTrack(currentTime);
+                    track->playTrack(renderTime);
                 }
                 else if (!inRegion && track->playing) {
                     track->stopTrack();
@@ -227,6 +305,8 @@ int main() {
 
                 track->updateMappings();
             }
+
+            ScenePreloader::update(GlobalTransport::currentTime);
         }
         else {
             for (auto& track : Timeline::timelineTracks) {
@@ -243,6 +323,10 @@ int main() {
         glClearColor(CLEAR_COL.x, CLEAR_COL.y, CLEAR_COL.z, CLEAR_COL.w);
         glClear(GL_COLOR_BUFFER_BIT);
 
+        ImportJobs::publish();
+        PcmCache::update();
+        TrackSet::reclaim();
+
         // Render UI windows
         float currTime = GlobalTransport::render();
         Timeline::render(currTime);
@@ -256,16 +340,38 @@ int main() {
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
         glfwSwapBuffers(window);
+
+        // A render queued from the File menu blocks the UI until it is written
+        if (OfflineRenderer::takeRequest(renderSettings))
+            OfflineRenderer::render(renderSettings);
+
+        // Opening a project replaces every track, so playback is parked around it
+        if (ProjectIO::takeLoadRequest(projectPath)) {
+            GlobalTransport::isPlaying = false;
+            AudioEngine::setOffline(true);
+            TrackStreamer::stop();
+            ProjectIO::load(projectPath);
+            TrackStreamer::start();
+            AudioEngine::setOffline(false);
+        }
+
         std::this_thread::yield();
     }
 
+    // Stop the audio thread before tearing down the decoders it reads
+    AudioEngine::shutdown(device);
+    TrackStreamer::stop();
+    TrackSet::shutdown();
+    PcmCache::shutdown();
+    ImportJobs::shutdown();
+    SidecarJobs::shutdown();
+    Trace::stop();
+
     // Cleanup tracks and resources
     for (auto& track : Timeline::timelineTracks) {
         track->unloadTrack();
     }
 
-    ma_device_uninit(&device);
-
     Canvas::shutdown();
 
     ImGui_ImplOpenGL3_Shutdown();